@@ -13,12 +13,19 @@
         "sources": [
         "src/async-future.cc",
         "src/batch.cc",
+        "src/bulk-query.cc",
         "src/cassandra-driver.cc",
         "src/client.cc",
+        "src/column-binder.cc",
+        "src/decoded-page.cc",
+        "src/lazy-row.cc",
         "src/logging.cc",
+        "src/prepared-cache.cc",
         "src/prepared-query.cc",
         "src/result.cc",
+        "src/result-schema.cc",
         "src/query.cc",
+        "src/string-table.cc",
         "src/type-mapper.cc",
 
         "cpp-driver/src/address.cpp",
@@ -46,6 +53,7 @@
         "cpp-driver/src/iterator.cpp",
         "cpp-driver/src/latency_aware_policy.cpp",
         "cpp-driver/src/logger.cpp",
+        "cpp-driver/src/lz4.cpp",
         "cpp-driver/src/map_iterator.cpp",
         "cpp-driver/src/md5.cpp",
         "cpp-driver/src/multiple_request_handler.cpp",
@@ -85,6 +93,7 @@
             "<!(node -e \"require('nan')\")",
             "cpp-driver/include",
             "cpp-driver/src/third_party/boost",
+            "cpp-driver/src/third_party/hdr_histogram",
             "cpp-driver/src/third_party/rapidjson"
       ]
     }
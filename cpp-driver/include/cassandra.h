@@ -435,6 +435,11 @@ typedef enum CassSslVerifyFlags {
   CASS_SSL_VERIFY_PEER_IDENTITY = 2
 } CassSslVerifyFlags;
 
+typedef enum CassCompression_ {
+  CASS_COMPRESSION_NONE,
+  CASS_COMPRESSION_LZ4
+} CassCompression;
+
 typedef enum  CassErrorSource_ {
   CASS_ERROR_SOURCE_NONE,
   CASS_ERROR_SOURCE_LIB,
@@ -644,7 +649,8 @@ cass_cluster_set_ssl(CassCluster* cluster,
  * Sets the protocol version. This will automatically downgrade if to
  * protocol version 1.
  *
- * Default: 2
+ * Default: 4 (the highest supported version), downgraded to the highest
+ * version supported by the cluster.
  *
  * @public @memberof CassCluster
  *
@@ -656,6 +662,39 @@ CASS_EXPORT CassError
 cass_cluster_set_protocol_version(CassCluster* cluster,
                                   int protocol_version);
 
+/**
+ * Sets the compression used for frames sent to and received from the
+ * cluster. Compression is only enabled on connections to nodes that
+ * advertise support for the algorithm.
+ *
+ * Default: CASS_COMPRESSION_NONE
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] compression
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_compression(CassCluster* cluster,
+                             CassCompression compression);
+
+/**
+ * Sets the smallest request body, in bytes, that will be compressed.
+ * Smaller requests are sent uncompressed because they don't benefit
+ * from it.
+ *
+ * Default: 512 bytes
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] threshold_bytes
+ */
+CASS_EXPORT void
+cass_cluster_set_compression_threshold(CassCluster* cluster,
+                                       unsigned threshold_bytes);
+
 /**
  * Sets the number of IO threads. This is the number of threads
  * that will handle query requests.
@@ -1658,6 +1697,19 @@ cass_future_set_callback(CassFuture* future,
 CASS_EXPORT cass_bool_t
 cass_future_ready(CassFuture* future);
 
+/**
+ * Gets the time at which the future was set, in nanoseconds on the
+ * same clock as uv_hrtime(). Unlike the time its callback runs, this
+ * doesn't depend on when the callback was set.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @return the time the future was set or 0 if it isn't set yet
+ */
+CASS_EXPORT cass_uint64_t
+cass_future_ready_time(CassFuture* future);
+
 /**
  * Wait for the future to be set with either a result or error.
  *
@@ -2689,6 +2741,64 @@ cass_prepared_free(const CassPrepared* prepared);
 CASS_EXPORT CassStatement*
 cass_prepared_bind(const CassPrepared* prepared);
 
+/**
+ * Gets the number of bind parameters of a prepared statement.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @return The number of parameters
+ */
+CASS_EXPORT size_t
+cass_prepared_parameter_count(const CassPrepared* prepared);
+
+/**
+ * Gets the value type of the specified bind parameter of a prepared
+ * statement, as returned by the server when the statement was prepared.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] index
+ * @return The parameter's value type. CASS_VALUE_TYPE_UNKNOWN
+ * is returned if the index is out of bounds.
+ */
+CASS_EXPORT CassValueType
+cass_prepared_parameter_type(const CassPrepared* prepared,
+                             size_t index);
+
+/**
+ * Gets the primary sub-type of the specified bind parameter of a prepared
+ * statement. This is the element type for a list or set and the key type
+ * for a map.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] index
+ * @return The parameter's primary sub-type. CASS_VALUE_TYPE_UNKNOWN
+ * is returned if the index is out of bounds or the parameter isn't a
+ * collection.
+ */
+CASS_EXPORT CassValueType
+cass_prepared_parameter_primary_sub_type(const CassPrepared* prepared,
+                                         size_t index);
+
+/**
+ * Gets the secondary sub-type of the specified bind parameter of a prepared
+ * statement. This is the value type for a map.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] index
+ * @return The parameter's secondary sub-type. CASS_VALUE_TYPE_UNKNOWN
+ * is returned if the index is out of bounds or the parameter isn't a map.
+ */
+CASS_EXPORT CassValueType
+cass_prepared_parameter_secondary_sub_type(const CassPrepared* prepared,
+                                           size_t index);
+
 /***********************************************************************************
  *
  * Batch
@@ -3340,6 +3450,32 @@ cass_row_get_column_by_name_n(const CassRow* row,
                               const char* name,
                               size_t name_length);
 
+/**
+ * Creates a copy of the specified row. Unlike the row returned by
+ * cass_iterator_get_row() the copy remains valid after the iterator
+ * advances. The copy's values still reference the result the row was
+ * obtained from so the result must outlive the copy.
+ *
+ * @public @memberof CassRow
+ *
+ * @param[in] row
+ * @return Returns a row that must be freed.
+ *
+ * @see cass_row_free()
+ */
+CASS_EXPORT CassRow*
+cass_row_copy(const CassRow* row);
+
+/**
+ * Frees a row created by cass_row_copy().
+ *
+ * @public @memberof CassRow
+ *
+ * @param[in] row
+ */
+CASS_EXPORT void
+cass_row_free(CassRow* row);
+
 /***********************************************************************************
  *
  * Value
@@ -50,15 +50,13 @@ CassError cass_batch_add_statement(CassBatch* batch, CassStatement* statement) {
 namespace cass {
 
 int BatchRequest::encode(int version, BufferVec* bufs) const {
-  if (version != 2) {
+  if (version < 2 || version > CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) {
     return ENCODE_ERROR_UNSUPPORTED_PROTOCOL;
   }
-  return encode_v2(bufs);
+  return encode_v2(version, bufs);
 }
 
-int BatchRequest::encode_v2(BufferVec* bufs) const {
-  const int version = 2;
-
+int BatchRequest::encode_v2(int version, BufferVec* bufs) const {
   size_t length = 0;
 
   {
@@ -111,7 +109,7 @@ int BatchRequest::encode_v2(BufferVec* bufs) const {
     }
   }
 
-  {
+  if (version == 2) {
     // <consistency> [short]
     size_t buf_size = sizeof(uint16_t);
 
@@ -119,6 +117,24 @@ int BatchRequest::encode_v2(BufferVec* bufs) const {
     buf.encode_uint16(0, consistency_);
     bufs->push_back(buf);
     length += buf_size;
+  } else {
+    // <consistency> [short] + <flags> [byte] + [<serial_consistency> [short]]
+    uint8_t flags = 0;
+    size_t buf_size = sizeof(uint16_t) + sizeof(uint8_t);
+
+    if (serial_consistency() != 0) {
+      buf_size += sizeof(uint16_t);
+      flags |= CASS_QUERY_FLAG_SERIAL_CONSISTENCY;
+    }
+
+    Buffer buf(buf_size);
+    size_t pos = buf.encode_uint16(0, consistency_);
+    pos = buf.encode_byte(pos, flags);
+    if (serial_consistency() != 0) {
+      buf.encode_uint16(pos, serial_consistency());
+    }
+    bufs->push_back(buf);
+    length += buf_size;
   }
 
   return length;
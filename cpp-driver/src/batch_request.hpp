@@ -56,7 +56,8 @@ public:
 
 private:
   int encode(int version, BufferVec* bufs) const;
-  int encode_v2(BufferVec* bufs) const;
+  // Protocol v2 and later. Starting with v3 the batch ends with flags.
+  int encode_v2(int version, BufferVec* bufs) const;
 
 private:
   typedef std::map<std::string, ExecuteRequest*> PreparedMap;
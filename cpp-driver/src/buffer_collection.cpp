@@ -16,6 +16,7 @@
 
 #include "buffer_collection.hpp"
 
+#include "constants.hpp"
 #include "types.hpp"
 
 
@@ -105,17 +106,28 @@ CassError cass_collection_append_decimal(CassCollection* collection,
 
 namespace cass {
 
+// Protocol v3 and later use an [int] instead of a [short] for the number of
+// elements and the size of each element.
+static size_t collection_size_size(int version) {
+  return version >= 3 ? sizeof(int32_t) : sizeof(uint16_t);
+}
+
 int BufferCollection::encode(int version, BufferVec* bufs) const {
-  if (version != 1 && version != 2) return -1;
+  if (version < 1 || version > CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) return -1;
 
-  int value_size = sizeof(uint16_t) + calculate_size(version);
+  int count = is_map_ ? bufs_.size() / 2 : bufs_.size();
+  int value_size = collection_size_size(version) + calculate_size(version);
   int buf_size = sizeof(int32_t) + value_size;
 
   Buffer buf(buf_size);
 
   int pos = 0;
   pos = buf.encode_int32(pos, value_size);
-  pos = buf.encode_uint16(pos, is_map_ ? bufs_.size() / 2 : bufs_.size());
+  if (version >= 3) {
+    pos = buf.encode_int32(pos, count);
+  } else {
+    pos = buf.encode_uint16(pos, count);
+  }
 
   encode(version, buf.data() + pos);
 
@@ -125,23 +137,28 @@ int BufferCollection::encode(int version, BufferVec* bufs) const {
 }
 
 int BufferCollection::calculate_size(int version) const {
-  if (version != 1 && version != 2) return -1;
+  if (version < 1 || version > CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) return -1;
   int value_size = 0;
   for (BufferVec::const_iterator it = bufs_.begin(),
       end = bufs_.end(); it != end; ++it) {
-    value_size += sizeof(uint16_t);
+    value_size += collection_size_size(version);
     value_size += it->size();
   }
   return value_size;
 }
 
 void BufferCollection::encode(int version, char* buf) const {
-  assert(version == 1 || version == 2);
+  assert(version >= 1 && version <= CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION);
   char* pos = buf;
   for (BufferVec::const_iterator it = bufs_.begin(),
       end = bufs_.end(); it != end; ++it) {
-    encode_uint16(pos, it->size());
-    pos += sizeof(uint16_t);
+    if (version >= 3) {
+      encode_int32(pos, it->size());
+      pos += sizeof(int32_t);
+    } else {
+      encode_uint16(pos, it->size());
+      pos += sizeof(uint16_t);
+    }
 
     memcpy(pos, it->data(), it->size());
     pos += it->size();
@@ -0,0 +1,89 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_BUFFER_POOL_HPP_INCLUDED__
+#define __CASS_BUFFER_POOL_HPP_INCLUDED__
+
+#include "macros.hpp"
+#include "ref_counted.hpp"
+
+#include <stddef.h>
+#include <vector>
+
+namespace cass {
+
+// A free list of the buffers that sockets are read into so that reads
+// don't go through the allocator. A pool is shared by all the connections
+// of an event loop and must only be used from that loop's thread.
+//
+// Responses may keep a reference to the read buffer their body was decoded
+// from. Such a buffer isn't recycled when it's released; it's freed once
+// the last response using it goes away.
+class BufferPool {
+public:
+  static const size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+  static const size_t DEFAULT_MAX_FREE = 16;
+
+  BufferPool(size_t buffer_size = DEFAULT_BUFFER_SIZE,
+             size_t max_free = DEFAULT_MAX_FREE)
+      : buffer_size_(buffer_size)
+      , max_free_(max_free) {}
+
+  ~BufferPool() {
+    for (std::vector<RefBuffer*>::iterator it = free_.begin(),
+         end = free_.end(); it != end; ++it) {
+      (*it)->dec_ref();
+    }
+  }
+
+  size_t buffer_size() const { return buffer_size_; }
+
+  // The returned buffer holds a reference for the caller
+  RefBuffer* acquire() {
+    if (free_.empty()) {
+      RefBuffer* buffer = RefBuffer::create(buffer_size_);
+      buffer->inc_ref();
+      return buffer;
+    }
+    RefBuffer* buffer = free_.back();
+    free_.pop_back();
+    return buffer;
+  }
+
+  void release(RefBuffer* buffer) {
+    if (buffer == NULL) {
+      return;
+    }
+    // Only a buffer without other references can be written to again
+    if (buffer->ref_count() == 1 && free_.size() < max_free_) {
+      free_.push_back(buffer);
+    } else {
+      buffer->dec_ref();
+    }
+  }
+
+private:
+  const size_t buffer_size_;
+  const size_t max_free_;
+  std::vector<RefBuffer*> free_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BufferPool);
+};
+
+} // namespace cass
+
+#endif
@@ -17,6 +17,7 @@
 #include "cluster.hpp"
 
 #include "common.hpp"
+#include "constants.hpp"
 #include "dc_aware_policy.hpp"
 #include "logger.hpp"
 #include "round_robin_policy.hpp"
@@ -47,13 +48,29 @@ void cass_cluster_set_ssl(CassCluster* cluster,
 
 CassError cass_cluster_set_protocol_version(CassCluster* cluster,
                                             int protocol_version) {
-  if (protocol_version != 1 && protocol_version != 2) {
+  if (protocol_version < 1 ||
+      protocol_version > CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) {
     return CASS_ERROR_LIB_BAD_PARAMS;
   }
   cluster->config().set_protocol_version(protocol_version);
   return CASS_OK;
 }
 
+CassError cass_cluster_set_compression(CassCluster* cluster,
+                                       CassCompression compression) {
+  if (compression != CASS_COMPRESSION_NONE &&
+      compression != CASS_COMPRESSION_LZ4) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_compression(compression);
+  return CASS_OK;
+}
+
+void cass_cluster_set_compression_threshold(CassCluster* cluster,
+                                            unsigned threshold_bytes) {
+  cluster->config().set_compression_threshold(threshold_bytes);
+}
+
 CassError cass_cluster_set_num_threads_io(CassCluster* cluster,
                                           unsigned num_threads) {
   if (num_threads == 0) {
@@ -19,8 +19,8 @@
 namespace cass {
 
 char* CollectionIterator::decode_value(char* position) {
-  uint16_t size;
-  char* buffer = decode_uint16(position, size);
+  int32_t size;
+  char* buffer = collection_->decode_element_size(position, &size);
 
   CassValueType type;
   if (collection_->type() == CASS_VALUE_TYPE_MAP) {
@@ -37,7 +37,9 @@ public:
 
   Config()
       : port_(9042)
-      , protocol_version_(2)
+      , protocol_version_(-1) // Highest supported, negotiated down if needed
+      , compression_(CASS_COMPRESSION_NONE)
+      , compression_threshold_(512)
       , thread_count_io_(1)
       , queue_size_io_(8192)
       , queue_size_event_(8192)
@@ -195,6 +197,18 @@ public:
     protocol_version_ = protocol_version;
   }
 
+  CassCompression compression() const { return compression_; }
+
+  void set_compression(CassCompression compression) {
+    compression_ = compression;
+  }
+
+  unsigned compression_threshold() const { return compression_threshold_; }
+
+  void set_compression_threshold(unsigned threshold_bytes) {
+    compression_threshold_ = threshold_bytes;
+  }
+
   CassLogLevel log_level() const { return log_level_; }
 
   void set_log_level(CassLogLevel log_level) {
@@ -273,6 +287,8 @@ public:
 private:
   int port_;
   int protocol_version_;
+  CassCompression compression_;
+  unsigned compression_threshold_;
   ContactPointList contact_points_;
   unsigned thread_count_io_;
   unsigned queue_size_io_;
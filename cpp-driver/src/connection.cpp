@@ -19,6 +19,7 @@
 #include "auth.hpp"
 #include "auth_requests.hpp"
 #include "auth_responses.hpp"
+#include "buffer_pool.hpp"
 #include "common.hpp"
 #include "constants.hpp"
 #include "connector.hpp"
@@ -35,6 +36,7 @@
 #include "logger.hpp"
 #include "cassandra.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -143,6 +145,7 @@ void Connection::StartupHandler::on_result_response(ResponseMessage* response) {
 Connection::Connection(uv_loop_t* loop,
                        const Config& config,
                        Metrics* metrics,
+                       BufferPool* buffer_pool,
                        const Address& address,
                        const std::string& keyspace,
                        int protocol_version,
@@ -157,12 +160,15 @@ Connection::Connection(uv_loop_t* loop,
     , loop_(loop)
     , config_(config)
     , metrics_(metrics)
+    , buffer_pool_(buffer_pool)
+    , read_buffer_(NULL)
     , address_(address)
     , addr_string_(address.to_string())
     , keyspace_(keyspace)
     , protocol_version_(protocol_version)
     , listener_(listener)
     , response_(new ResponseMessage())
+    , stream_manager_(protocol_version)
     , version_("3.0.0")
     , connect_timer_(NULL)
     , ssl_session_(NULL) {
@@ -196,7 +202,7 @@ void Connection::connect() {
 }
 
 bool Connection::write(Handler* handler, bool flush_immediately) {
-  int8_t stream = stream_manager_.acquire_stream(handler);
+  int16_t stream = stream_manager_.acquire_stream(handler);
   if (stream < 0) {
     return false;
   }
@@ -295,12 +301,13 @@ void Connection::set_is_available(bool is_available) {
   }
 }
 
-void Connection::consume(char* input, size_t size) {
+void Connection::consume(char* input, size_t size, RefBuffer* input_buffer) {
   char* buffer = input;
   size_t remaining = size;
 
   while (remaining != 0) {
-    int consumed = response_->decode(protocol_version_, buffer, remaining);
+    int consumed = response_->decode(protocol_version_, buffer, remaining,
+                                     input_buffer);
     if (consumed <= 0) {
       notify_error("Error consuming message");
       remaining = 0;
@@ -452,14 +459,24 @@ void Connection::on_close(uv_handle_t* handle) {
   delete connection;
 }
 
+// Read buffers come from the event loop's pool and are handed back as soon as
+// they're consumed, so the pool's buffer size is used regardless of the
+// size libuv suggests. Every allocation is followed by a read callback so
+// the connection only tracks the buffer of the current read.
 #if UV_VERSION_MAJOR == 0
 uv_buf_t Connection::alloc_buffer(uv_handle_t* handle, size_t suggested_size) {
-  return uv_buf_init(new char[suggested_size], suggested_size);
+  Connection* connection = static_cast<Connection*>(handle->data);
+  BufferPool* pool = connection->buffer_pool_;
+  connection->read_buffer_ = pool->acquire();
+  return uv_buf_init(connection->read_buffer_->data(), pool->buffer_size());
 }
 #else
 void Connection::alloc_buffer(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf) {
-  buf->base = new char[suggested_size];
-  buf->len = suggested_size;
+  Connection* connection = static_cast<Connection*>(handle->data);
+  BufferPool* pool = connection->buffer_pool_;
+  connection->read_buffer_ = pool->acquire();
+  buf->base = connection->read_buffer_->data();
+  buf->len = pool->buffer_size();
 }
 #endif
 
@@ -469,6 +486,8 @@ void Connection::on_read(uv_stream_t* client, ssize_t nread, uv_buf_t buf) {
 void Connection::on_read(uv_stream_t* client, ssize_t nread, const uv_buf_t* buf) {
 #endif
   Connection* connection = static_cast<Connection*>(client->data);
+  RefBuffer* read_buffer = connection->read_buffer_;
+  connection->read_buffer_ = NULL;
 
   if (nread < 0) {
 #if UV_VERSION_MAJOR == 0
@@ -481,21 +500,16 @@ void Connection::on_read(uv_stream_t* client, ssize_t nread, const uv_buf_t* buf
                 connection->addr_string_.c_str());
     }
     connection->defunct();
-#if UV_VERSION_MAJOR == 0
-    delete[] buf.base;
-#else
-    delete[] buf->base;
-#endif
+    connection->buffer_pool_->release(read_buffer);
     return;
   }
 
 #if UV_VERSION_MAJOR == 0
-  connection->consume(buf.base, nread);
-  delete[] buf.base;
+  connection->consume(buf.base, nread, read_buffer);
 #else
-  connection->consume(buf->base, nread);
-  delete[] buf->base;
+  connection->consume(buf->base, nread, read_buffer);
 #endif
+  connection->buffer_pool_->release(read_buffer);
 }
 
 #if UV_VERSION_MAJOR == 0
@@ -613,10 +627,17 @@ void Connection::on_supported(ResponseMessage* response) {
   SupportedResponse* supported =
       static_cast<SupportedResponse*>(response->response_body().get());
 
-  // TODO(mstump) do something with the supported info
-  (void)supported;
+  if (config_.compression() == CASS_COMPRESSION_LZ4) {
+    const std::list<std::string>& compression = supported->compression();
+    if (std::find(compression.begin(), compression.end(), "lz4") != compression.end()) {
+      compression_ = "lz4";
+    } else {
+      LOG_WARN("Host %s doesn't support LZ4 compression, frames will be sent uncompressed",
+               addr_string_.c_str());
+    }
+  }
 
-  write(new StartupHandler(this, new StartupRequest()));
+  write(new StartupHandler(this, new StartupRequest(compression_)));
 }
 
 void Connection::on_pending_schema_agreement(Timer* timer) {
@@ -723,7 +744,16 @@ Connection::PendingWriteBase::~PendingWriteBase() {
 
 int32_t Connection::PendingWriteBase::write(Handler* handler) {
   size_t last_buffer_size = buffers_.size();
-  int32_t request_size = handler->encode(connection_->protocol_version_, 0x00, &buffers_);
+  // Only requests sent after startup are compressed
+  int flags = 0x00;
+  if (connection_->state_ == CONNECTION_STATE_READY &&
+      !connection_->compression_.empty()) {
+    flags |= CASS_FLAG_COMPRESSION;
+  }
+
+  int32_t request_size = handler->encode(connection_->protocol_version_, flags,
+                                         connection_->config_.compression_threshold(),
+                                         &buffers_);
   if (request_size < 0) {
     buffers_.resize(last_buffer_size); // rollback
     return request_size;
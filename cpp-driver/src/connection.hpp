@@ -38,6 +38,7 @@ namespace cass {
 
 class AuthProvider;
 class AuthResponseRequest;
+class BufferPool;
 class Config;
 class Connector;
 class EventResponse;
@@ -77,6 +78,7 @@ public:
   Connection(uv_loop_t* loop,
              const Config& config,
              Metrics* metrics,
+             BufferPool* buffer_pool,
              const Address& address,
              const std::string& keyspace,
              int protocol_version,
@@ -229,7 +231,9 @@ private:
 
   void set_is_available(bool is_available);
   void actually_close();
-  void consume(char* input, size_t size);
+  // Frame bodies contained in "input_buffer", if given, reference it rather
+  // than being copied
+  void consume(char* input, size_t size, RefBuffer* input_buffer = NULL);
   void maybe_set_keyspace(ResponseMessage* response);
 
   static void on_connect(Connector* connecter);
@@ -286,6 +290,8 @@ private:
   uv_loop_t* loop_;
   const Config& config_;
   Metrics* metrics_;
+  BufferPool* buffer_pool_;
+  RefBuffer* read_buffer_;
   Address address_;
   std::string addr_string_;
   std::string keyspace_;
@@ -57,6 +57,7 @@
 #define CASS_QUERY_FLAG_PAGE_SIZE 0x04
 #define CASS_QUERY_FLAG_PAGING_STATE 0x08
 #define CASS_QUERY_FLAG_SERIAL_CONSISTENCY 0x10
+#define CASS_QUERY_FLAG_DEFAULT_TIMESTAMP 0x20
 
 #define CASS_BATCH_KIND_QUERY 0
 #define CASS_BATCH_KIND_PREPARED 1
@@ -71,11 +72,26 @@
 #define CASS_RESULT_FLAG_HAS_MORE_PAGES 2
 #define CASS_RESULT_FLAG_NO_METADATA 4
 
+// Option ids for types added in protocol v3 that the driver doesn't decode
+#define CQL_TYPE_UDT 0x30
+#define CQL_TYPE_TUPLE 0x31
+
 #define CASS_EVENT_TOPOLOGY_CHANGE 1
 #define CASS_EVENT_STATUS_CHANGE 2
 #define CASS_EVENT_SCHEMA_CHANGE 4
 
 #define CASS_HEADER_SIZE_V1_AND_V2 8
+#define CASS_HEADER_SIZE_V3 9
+
+// The largest frame body the protocol allows (256 MB)
+#define CASS_MAX_FRAME_BODY_SIZE (256 * 1024 * 1024)
+
+#define CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION 4
+
+#define CASS_FLAG_COMPRESSION 0x01
+#define CASS_FLAG_TRACING 0x02
+#define CASS_FLAG_CUSTOM_PAYLOAD 0x04
+#define CASS_FLAG_WARNING 0x08
 
 enum RetryType { RETRY_WITH_CURRENT_HOST, RETRY_WITH_NEXT_HOST };
 
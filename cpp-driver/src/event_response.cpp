@@ -66,8 +66,22 @@ bool EventResponse::decode(int version, char* buffer, size_t size) {
     } else {
       return false;
     }
-    pos = decode_string(pos, &keyspace_, keyspace_size_);
-    decode_string(pos, &table_, table_size_);
+    if (version >= 3) {
+      // <target> [string] + <options>. Changes to anything other than a
+      // keyspace or table are reported as an update of the keyspace, which
+      // refreshes its metadata.
+      StringRef target;
+      pos = decode_string_ref(pos, &target);
+      pos = decode_string(pos, &keyspace_, keyspace_size_);
+      if (target == "TABLE") {
+        decode_string(pos, &table_, table_size_);
+      } else if (target != "KEYSPACE") {
+        schema_change_ = UPDATED;
+      }
+    } else {
+      pos = decode_string(pos, &keyspace_, keyspace_size_);
+      decode_string(pos, &table_, table_size_);
+    }
   } else {
     return false;
   }
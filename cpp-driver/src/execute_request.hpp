@@ -48,7 +48,9 @@ public:
 private:
   int encode(int version, BufferVec* bufs) const;
   int encode_v1(BufferVec* bufs) const;
-  int encode_v2(BufferVec* bufs) const;
+  // Protocol v2 and later, which only differ in how collection values are
+  // encoded
+  int encode_v2(int version, BufferVec* bufs) const;
 
 private:
   SharedRefPtr<const Prepared> prepared_;
@@ -41,6 +41,10 @@ cass_bool_t cass_future_ready(CassFuture* future) {
   return static_cast<cass_bool_t>(future->ready());
 }
 
+cass_uint64_t cass_future_ready_time(CassFuture* future) {
+  return future->ready_time();
+}
+
 void cass_future_wait(CassFuture* future) {
   future->wait();
 }
@@ -135,6 +139,7 @@ bool Future::set_callback(Future::Callback callback, void* data) {
 
 void Future::internal_set(ScopedMutex& lock) {
   is_set_ = true;
+  ready_time_ = uv_hrtime();
   uv_cond_broadcast(&cond_);
   if (callback_) {
     if (loop_.load() == NULL) {
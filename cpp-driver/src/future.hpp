@@ -53,6 +53,7 @@ public:
 
   Future(FutureType type)
       : is_set_(false)
+      , ready_time_(0)
       , type_(type)
       , loop_(NULL)
       , callback_(NULL) {
@@ -72,6 +73,12 @@ public:
     return is_set_;
   }
 
+  // The uv_hrtime() at which the future was set, or 0 if it isn't set yet
+  uint64_t ready_time() {
+    ScopedMutex lock(&mutex_);
+    return ready_time_;
+  }
+
   virtual void wait() {
     ScopedMutex lock(&mutex_);
     internal_wait(lock);
@@ -138,6 +145,7 @@ private:
 
 private:
   bool is_set_;
+  uint64_t ready_time_;
   uv_cond_t cond_;
   FutureType type_;
   ScopedPtr<Error> error_;
@@ -20,14 +20,54 @@
 #include "connection.hpp"
 #include "constants.hpp"
 #include "logger.hpp"
+#include "lz4.hpp"
 #include "request.hpp"
 #include "result_response.hpp"
 #include "serialization.hpp"
 
+#include <vector>
+
+namespace {
+
+// Replaces the body buffers starting at "first" with a single buffer holding
+// the uncompressed length followed by the LZ4 compressed body. The body is
+// left alone if it doesn't get any smaller.
+bool compress_body(size_t first, int32_t* length, cass::BufferVec* bufs) {
+  if (*length == 0) {
+    return false;
+  }
+
+  std::vector<char> body;
+  body.reserve(*length);
+  for (cass::BufferVec::const_iterator it = bufs->begin() + first,
+       end = bufs->end(); it != end; ++it) {
+    body.insert(body.end(), it->data(), it->data() + it->size());
+  }
+
+  std::vector<char> compressed(sizeof(int32_t) +
+                               cass::lz4_compress_bound(body.size()));
+  cass::encode_int32(&compressed[0], *length);
+  size_t compressed_size = cass::lz4_compress(&body[0], body.size(),
+                                              &compressed[sizeof(int32_t)],
+                                              compressed.size() - sizeof(int32_t));
+  if (compressed_size == 0 ||
+      sizeof(int32_t) + compressed_size >= static_cast<size_t>(*length)) {
+    return false;
+  }
+
+  *length = static_cast<int32_t>(sizeof(int32_t) + compressed_size);
+  bufs->resize(first);
+  bufs->push_back(cass::Buffer(&compressed[0], *length));
+  return true;
+}
+
+} // namespace
+
 namespace cass {
 
-int32_t Handler::encode(int version, int flags, BufferVec* bufs) const {
-  if (version != 1 && version != 2) {
+int32_t Handler::encode(int version, int flags, size_t compression_threshold,
+                        BufferVec* bufs) const {
+  if (version < 1 || version > CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) {
     return Request::ENCODE_ERROR_UNSUPPORTED_PROTOCOL;
   }
 
@@ -40,16 +80,31 @@ int32_t Handler::encode(int version, int flags, BufferVec* bufs) const {
     return length;
   }
 
-  Buffer buf(CASS_HEADER_SIZE_V1_AND_V2);
+  if (flags & CASS_FLAG_COMPRESSION) {
+    if (static_cast<size_t>(length) < compression_threshold ||
+        !compress_body(index + 1, &length, bufs)) {
+      flags &= ~CASS_FLAG_COMPRESSION;
+    }
+  }
+
+  // Starting with v3 the stream id is a [short] instead of a [byte]
+  size_t header_size = version >= 3 ? CASS_HEADER_SIZE_V3
+                                    : CASS_HEADER_SIZE_V1_AND_V2;
+
+  Buffer buf(header_size);
   size_t pos = 0;
   pos = buf.encode_byte(pos, version);
   pos = buf.encode_byte(pos, flags);
-  pos = buf.encode_byte(pos, stream_);
+  if (version >= 3) {
+    pos = buf.encode_uint16(pos, static_cast<uint16_t>(stream_));
+  } else {
+    pos = buf.encode_byte(pos, stream_);
+  }
   pos = buf.encode_byte(pos, req->opcode());
   buf.encode_int32(pos, length);
   (*bufs)[index] = buf;
 
-  return length + CASS_HEADER_SIZE_V1_AND_V2;
+  return length + header_size;
 }
 
 void Handler::set_state(Handler::State next_state) {
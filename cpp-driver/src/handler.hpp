@@ -108,7 +108,8 @@ public:
 
   virtual const Request* request() const = 0;
 
-  int32_t encode(int version, int flags, BufferVec* bufs) const;
+  int32_t encode(int version, int flags, size_t compression_threshold,
+                 BufferVec* bufs) const;
 
   virtual void start_request() {}
 
@@ -122,9 +123,9 @@ public:
     connection_ = connection;
   }
 
-  int8_t stream() const { return stream_; }
+  int16_t stream() const { return stream_; }
 
-  void set_stream(int8_t stream) {
+  void set_stream(int16_t stream) {
     stream_ = stream;
   }
 
@@ -146,7 +147,7 @@ protected:
 
 private:
   RequestTimer timer_;
-  int8_t stream_;
+  int16_t stream_;
   State state_;
 
 private:
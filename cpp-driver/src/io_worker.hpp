@@ -20,6 +20,7 @@
 #include "address.hpp"
 #include "atomic.hpp"
 #include "async_queue.hpp"
+#include "buffer_pool.hpp"
 #include "constants.hpp"
 #include "event_thread.hpp"
 #include "logger.hpp"
@@ -100,6 +101,8 @@ public:
 
   void add_pending_flush(Pool* pool);
 
+  BufferPool* buffer_pool() { return &buffer_pool_; }
+
 private:
   void add_pool(const Address& address, bool is_initial_connection);
   void maybe_close();
@@ -154,6 +157,7 @@ private:
   bool is_closing_;
   int pending_request_count_;
   PendingReconnectMap pending_reconnects_;
+  BufferPool buffer_pool_;
 
   AsyncQueue<SPSCQueue<RequestHandler*> > request_queue_;
 };
@@ -0,0 +1,223 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "lz4.hpp"
+
+#include <uv.h>
+#include <string.h>
+
+#define LZ4_MIN_MATCH 4
+#define LZ4_LAST_LITERALS 5    // The last 5 bytes are always literals
+#define LZ4_MF_LIMIT 12        // The last match must start 12 bytes before the end
+#define LZ4_MAX_OFFSET 65535
+#define LZ4_HASH_LOG 12
+#define LZ4_HASH_SIZE (1 << LZ4_HASH_LOG)
+#define LZ4_SKIP_TRIGGER 6
+
+namespace {
+
+inline uint32_t read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint32_t hash32(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - LZ4_HASH_LOG);
+}
+
+// Writes the remainder of a length that doesn't fit in a token nibble
+inline uint8_t* encode_length(uint8_t* op, size_t length) {
+  for (; length >= 255; length -= 255) {
+    *op++ = 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+inline size_t sequence_size(size_t literals, size_t match) {
+  return 1 + (literals >= 15 ? (literals - 15) / 255 + 1 : 0) + literals +
+      (match > 0 ? 2 + (match >= 15 ? (match - 15) / 255 + 1 : 0) : 0);
+}
+
+// Emits a sequence, a match length of 0 marks the last literals-only sequence
+uint8_t* encode_sequence(uint8_t* op, const uint8_t* literals,
+                         size_t literals_size,
+                         size_t offset, size_t match_size) {
+  uint8_t* token = op++;
+  *token = static_cast<uint8_t>((literals_size >= 15 ? 15 : literals_size) << 4);
+  if (literals_size >= 15) {
+    op = encode_length(op, literals_size - 15);
+  }
+  if (literals_size > 0) { // The literals may be NULL when there are none
+    memcpy(op, literals, literals_size);
+    op += literals_size;
+  }
+
+  if (match_size > 0) {
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    size_t length = match_size - LZ4_MIN_MATCH;
+    *token |= static_cast<uint8_t>(length >= 15 ? 15 : length);
+    if (length >= 15) {
+      op = encode_length(op, length - 15);
+    }
+  }
+
+  return op;
+}
+
+} // namespace
+
+namespace cass {
+
+size_t lz4_compress_bound(size_t size) {
+  return size + size / 255 + 16;
+}
+
+size_t lz4_compress(const char* input, size_t size,
+                    char* output, size_t capacity) {
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(input);
+  uint8_t* op = reinterpret_cast<uint8_t*>(output);
+  uint8_t* op_end = op + capacity;
+
+  size_t anchor = 0;
+
+  if (size >= LZ4_MF_LIMIT + 1) {
+    // Positions are stored off by one so that zero means empty
+    uint32_t table[LZ4_HASH_SIZE];
+    memset(table, 0, sizeof(table));
+
+    const size_t match_limit = size - LZ4_LAST_LITERALS;
+    const size_t search_limit = size - LZ4_MF_LIMIT;
+    size_t pos = 0;
+    size_t attempts = 1 << LZ4_SKIP_TRIGGER;
+
+    while (pos < search_limit) {
+      uint32_t sequence = read32(src + pos);
+      uint32_t hash = hash32(sequence);
+      size_t candidate = table[hash];
+      table[hash] = static_cast<uint32_t>(pos + 1);
+
+      if (candidate == 0 ||
+          pos - (candidate - 1) > LZ4_MAX_OFFSET ||
+          read32(src + candidate - 1) != sequence) {
+        // Step further through input that doesn't compress
+        pos += attempts++ >> LZ4_SKIP_TRIGGER;
+        continue;
+      }
+      --candidate;
+
+      size_t end = pos + LZ4_MIN_MATCH;
+      size_t ref = candidate + LZ4_MIN_MATCH;
+      while (end < match_limit && src[end] == src[ref]) {
+        ++end;
+        ++ref;
+      }
+
+      size_t literals_size = pos - anchor;
+      size_t match_size = end - pos;
+      if (sequence_size(literals_size, match_size) >
+          static_cast<size_t>(op_end - op)) {
+        return 0;
+      }
+      op = encode_sequence(op, src + anchor, literals_size,
+                           pos - candidate, match_size);
+
+      pos = anchor = end;
+      attempts = 1 << LZ4_SKIP_TRIGGER;
+    }
+  }
+
+  size_t literals_size = size - anchor;
+  if (sequence_size(literals_size, 0) > static_cast<size_t>(op_end - op)) {
+    return 0;
+  }
+  op = encode_sequence(op, src + anchor, literals_size, 0, 0);
+
+  return op - reinterpret_cast<uint8_t*>(output);
+}
+
+int lz4_decompress(const char* input, size_t size,
+                   char* output, size_t capacity) {
+  const uint8_t* ip = reinterpret_cast<const uint8_t*>(input);
+  const uint8_t* ip_end = ip + size;
+  uint8_t* op = reinterpret_cast<uint8_t*>(output);
+  uint8_t* op_start = op;
+  uint8_t* op_end = op + capacity;
+
+  while (ip < ip_end) {
+    uint8_t token = *ip++;
+
+    size_t literals_size = token >> 4;
+    if (literals_size == 15) {
+      uint8_t b;
+      do {
+        if (ip >= ip_end) return -1;
+        b = *ip++;
+        literals_size += b;
+      } while (b == 255);
+    }
+
+    if (literals_size > static_cast<size_t>(ip_end - ip) ||
+        literals_size > static_cast<size_t>(op_end - op)) {
+      return -1;
+    }
+    memcpy(op, ip, literals_size);
+    ip += literals_size;
+    op += literals_size;
+
+    if (ip == ip_end) break; // The last sequence has no match
+
+    if (ip_end - ip < 2) return -1;
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - op_start)) {
+      return -1;
+    }
+
+    size_t match_size = token & 0x0F;
+    if (match_size == 15) {
+      uint8_t b;
+      do {
+        if (ip >= ip_end) return -1;
+        b = *ip++;
+        match_size += b;
+      } while (b == 255);
+    }
+    match_size += LZ4_MIN_MATCH;
+
+    if (match_size > static_cast<size_t>(op_end - op)) {
+      return -1;
+    }
+
+    // A match that overlaps its own output repeats the last offset bytes, so
+    // it has to be copied forward a byte at a time
+    const uint8_t* match = op - offset;
+    if (offset >= match_size) {
+      memcpy(op, match, match_size);
+    } else {
+      for (size_t i = 0; i < match_size; ++i) {
+        op[i] = match[i];
+      }
+    }
+    op += match_size;
+  }
+
+  return static_cast<int>(op - op_start);
+}
+
+} // namespace cass
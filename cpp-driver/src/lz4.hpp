@@ -0,0 +1,42 @@
+/*
+  Copyright (c) 2014-2015 DataStax
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_LZ4_HPP_INCLUDED__
+#define __CASS_LZ4_HPP_INCLUDED__
+
+#include <stddef.h>
+
+namespace cass {
+
+// A minimal implementation of the LZ4 block format
+// (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), which is
+// what Cassandra uses to compress frame bodies.
+
+// The largest possible compressed size of "size" bytes of input
+size_t lz4_compress_bound(size_t size);
+
+// Returns the compressed size or 0 if the output doesn't fit in "capacity"
+size_t lz4_compress(const char* input, size_t size,
+                    char* output, size_t capacity);
+
+// Returns the decompressed size or -1 if the input is malformed or the
+// output doesn't fit in "capacity"
+int lz4_decompress(const char* input, size_t size,
+                   char* output, size_t capacity);
+
+} // namespace cass
+
+#endif
@@ -19,12 +19,12 @@
 namespace cass {
 
 char* MapIterator::decode_pair(char* position) {
-  uint16_t size;
+  int32_t size;
 
-  position = decode_uint16(position, size);
+  position = map_->decode_element_size(position, &size);
   key_ = Value(map_->primary_type(), position, size);
 
-  position = decode_uint16(position + size, size);
+  position = map_->decode_element_size(position + size, &size);
   value_ = Value(map_->secondary_type(), position, size);
 
   return position + size;
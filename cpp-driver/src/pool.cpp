@@ -228,6 +228,7 @@ void Pool::spawn_connection() {
   if (state_ != POOL_STATE_CLOSING && state_ != POOL_STATE_CLOSED) {
     Connection* connection =
         new Connection(loop_, config_, metrics_,
+                       io_worker_->buffer_pool(),
                        address_,
                        io_worker_->keyspace(),
                        io_worker_->protocol_version(),
@@ -33,6 +33,39 @@ CassStatement* cass_prepared_bind(const CassPrepared* prepared) {
   return CassStatement::to(execute);
 }
 
+size_t cass_prepared_parameter_count(const CassPrepared* prepared) {
+  return prepared->result()->column_count();
+}
+
+CassValueType cass_prepared_parameter_type(const CassPrepared* prepared,
+                                           size_t index) {
+  const cass::ResultResponse* result = prepared->result().get();
+  if (index < static_cast<size_t>(result->column_count())) {
+    return static_cast<CassValueType>(result->metadata()->get(index).type);
+  }
+  return CASS_VALUE_TYPE_UNKNOWN;
+}
+
+CassValueType cass_prepared_parameter_primary_sub_type(const CassPrepared* prepared,
+                                                       size_t index) {
+  const cass::ResultResponse* result = prepared->result().get();
+  if (index < static_cast<size_t>(result->column_count())) {
+    return static_cast<CassValueType>(
+          result->metadata()->get(index).collection_primary_type);
+  }
+  return CASS_VALUE_TYPE_UNKNOWN;
+}
+
+CassValueType cass_prepared_parameter_secondary_sub_type(const CassPrepared* prepared,
+                                                         size_t index) {
+  const cass::ResultResponse* result = prepared->result().get();
+  if (index < static_cast<size_t>(result->column_count())) {
+    return static_cast<CassValueType>(
+          result->metadata()->get(index).collection_secondary_type);
+  }
+  return CASS_VALUE_TYPE_UNKNOWN;
+}
+
 } // extern "C"
 
 namespace cass {
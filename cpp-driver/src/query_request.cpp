@@ -23,8 +23,8 @@ namespace cass {
 int QueryRequest::encode(int version, BufferVec* bufs) const {
   if (version == 1) {
     return encode_v1(bufs);
-  } else if (version == 2) {
-    return encode_v2(bufs);
+  } else if (version <= CASS_HIGHEST_SUPPORTED_PROTOCOL_VERSION) {
+    return encode_v2(version, bufs);
   } else {
     return ENCODE_ERROR_UNSUPPORTED_PROTOCOL;
   }
@@ -42,9 +42,7 @@ int QueryRequest::encode_v1(BufferVec* bufs) const {
   return length;
 }
 
-int QueryRequest::encode_v2(BufferVec* bufs) const {
-  const int version = 2;
-
+int QueryRequest::encode_v2(int version, BufferVec* bufs) const {
   uint8_t flags = 0;
   size_t length = 0;
 
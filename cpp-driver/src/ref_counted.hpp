@@ -63,7 +63,7 @@ public:
 #pragma warning(push)
 #pragma warning(disable: 4291) //Invalid warning thrown RefBuffer has a delete function
 #endif
-    return new (size) RefBuffer();
+    return new (size) RefBuffer(size);
 #if defined(_WIN32)
 #pragma warning(pop)
 #endif
@@ -73,17 +73,22 @@ public:
     return reinterpret_cast<char*>(this) + sizeof(RefBuffer);
   }
 
+  size_t size() const { return size_; }
+
   void operator delete(void* ptr) {
     ::operator delete(ptr);
   }
 
 private:
-  RefBuffer() {}
+  RefBuffer(size_t size)
+    : size_(size) {}
 
   void* operator new(size_t size, size_t extra) {
     return ::operator new(size + extra);
   }
 
+  size_t size_;
+
   DISALLOW_COPY_AND_ASSIGN(RefBuffer);
 };
 
@@ -22,10 +22,59 @@
 #include "ready_response.hpp"
 #include "result_response.hpp"
 #include "supported_response.hpp"
+#include "logger.hpp"
+#include "lz4.hpp"
 #include "serialization.hpp"
 
+// Only bodies that fill at least this fraction of the read buffer they
+// arrived in are decoded in place. Smaller ones are copied, which is cheap,
+// rather than keeping the whole buffer alive for as long as the response is
+// used.
+#define MIN_SHARED_BODY_FRACTION 4
+
 namespace cass {
 
+namespace {
+
+// Bounds checked decoders for the body prefix, which return false if the
+// value would run past the end of the body
+
+bool decode_uint16_within(char** pos, const char* end, uint16_t* output) {
+  if (end - *pos < static_cast<ptrdiff_t>(sizeof(uint16_t))) {
+    return false;
+  }
+  *pos = decode_uint16(*pos, *output);
+  return true;
+}
+
+bool decode_string_within(char** pos, const char* end, StringRef* output) {
+  uint16_t size = 0;
+  if (!decode_uint16_within(pos, end, &size) || end - *pos < size) {
+    return false;
+  }
+  *output = StringRef(*pos, size);
+  *pos += size;
+  return true;
+}
+
+bool skip_bytes_within(char** pos, const char* end) {
+  if (end - *pos < static_cast<ptrdiff_t>(sizeof(int32_t))) {
+    return false;
+  }
+  int32_t size = 0;
+  *pos = decode_int32(*pos, size);
+  if (size < 0) { // Null
+    return true;
+  }
+  if (end - *pos < size) {
+    return false;
+  }
+  *pos += size;
+  return true;
+}
+
+} // namespace
+
 bool ResponseMessage::allocate_body(int8_t opcode) {
   response_body_.reset();
   switch (opcode) {
@@ -67,29 +116,131 @@ bool ResponseMessage::allocate_body(int8_t opcode) {
   }
 }
 
-int ResponseMessage::decode(int version, char* input, size_t size) {
+void ResponseMessage::copy_body(const char* input, size_t size) {
+  if (body_buffer_pos_ == NULL) {
+    response_body_->set_buffer(length_);
+    body_buffer_pos_ = response_body_->data();
+  }
+  memcpy(body_buffer_pos_, input, size);
+  body_buffer_pos_ += size;
+}
+
+bool ResponseMessage::decompress_body(size_t* size) {
+  // <uncompressed length> [int] followed by an LZ4 block
+  if (*size < sizeof(int32_t)) {
+    return false;
+  }
+
+  // Keeps the compressed body alive while it's decompressed
+  SharedRefPtr<RefBuffer> compressed_buffer(response_body_->buffer());
+  char* compressed = response_body_->data();
+  int32_t uncompressed_size = 0;
+  decode_int32(compressed, uncompressed_size);
+  if (uncompressed_size < 0 || uncompressed_size > CASS_MAX_FRAME_BODY_SIZE) {
+    LOG_ERROR("Invalid uncompressed body size %d", uncompressed_size);
+    return false;
+  }
+
+  response_body_->set_buffer(uncompressed_size);
+  int decompressed_size = lz4_decompress(compressed + sizeof(int32_t),
+                                         *size - sizeof(int32_t),
+                                         response_body_->data(),
+                                         uncompressed_size);
+  if (decompressed_size != uncompressed_size) {
+    return false;
+  }
+
+  *size = uncompressed_size;
+  return true;
+}
+
+bool ResponseMessage::decode_body_prefix(char** body, size_t* size) {
+  char* pos = *body;
+  char* end = *body + *size;
+
+  if (flags_ & CASS_FLAG_TRACING) {
+    if (end - pos < 16) {
+      return false;
+    }
+    pos += 16; // <tracing_id> [uuid]
+  }
+
+  if (flags_ & CASS_FLAG_WARNING) { // <warnings> [string list]
+    uint16_t count = 0;
+    if (!decode_uint16_within(&pos, end, &count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+      StringRef warning;
+      if (!decode_string_within(&pos, end, &warning)) {
+        return false;
+      }
+      LOG_WARN("Server-side warning: %.*s",
+               static_cast<int>(warning.size()), warning.data());
+    }
+  }
+
+  if (flags_ & CASS_FLAG_CUSTOM_PAYLOAD) { // <custom_payload> [bytes map]
+    uint16_t count = 0;
+    if (!decode_uint16_within(&pos, end, &count)) {
+      return false;
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+      StringRef key;
+      if (!decode_string_within(&pos, end, &key) ||
+          !skip_bytes_within(&pos, end)) {
+        return false;
+      }
+    }
+  }
+
+  *size = end - pos;
+  *body = pos;
+  return true;
+}
+
+int ResponseMessage::decode(int version, char* input, size_t size,
+                            RefBuffer* input_buffer) {
   char* input_pos = input;
 
   received_ += size;
 
   if (!is_header_received_) {
-    if (received_ >= CASS_HEADER_SIZE_V1_AND_V2) {
+    // The size of the header depends on the version of the frame, which
+    // is taken from the frame itself rather than the connection because a
+    // server that doesn't support the requested version responds with its
+    // own.
+    if (header_buffer_pos_ == header_buffer_) {
+      header_size_ = (input[0] & 0x7F) >= 3 ? CASS_HEADER_SIZE_V3
+                                            : CASS_HEADER_SIZE_V1_AND_V2;
+    }
+
+    if (received_ >= header_size_) {
       // We may have received more data then we need, only copy what we need
-      size_t overage = received_ - CASS_HEADER_SIZE_V1_AND_V2;
+      size_t overage = received_ - header_size_;
       size_t needed = size - overage;
 
       memcpy(header_buffer_pos_, input_pos, needed);
       header_buffer_pos_ += needed;
       input_pos += needed;
-      assert(header_buffer_pos_ == header_buffer_ + CASS_HEADER_SIZE_V1_AND_V2);
+      assert(header_buffer_pos_ == header_buffer_ + header_size_);
 
       char* buffer = header_buffer_;
       version_ = *(buffer++);
       flags_ = *(buffer++);
-      stream_ = *(buffer++);
+      if ((version_ & 0x7F) >= 3) {
+        uint16_t stream = 0;
+        buffer = decode_uint16(buffer, stream);
+        stream_ = static_cast<int16_t>(stream);
+      } else {
+        stream_ = static_cast<int8_t>(*(buffer++));
+      }
       opcode_ = *(buffer++);
 
       decode_int32(buffer, length_);
+      if (length_ < 0) {
+        return -1;
+      }
 
       is_header_received_ = true;
 
@@ -97,8 +248,7 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
         return -1;
       }
 
-      response_body_->set_buffer(length_);
-      body_buffer_pos_ = response_body_->data();
+      // The body's buffer is set when its first bytes are received
     } else {
       // We haven't received all the data for the header. We consume the
       // entire buffer.
@@ -109,19 +259,32 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
   }
 
   const size_t remaining = size - (input_pos - input);
-  const size_t frame_size = CASS_HEADER_SIZE_V1_AND_V2 + length_;
+  const size_t frame_size = header_size_ + length_;
 
   if (received_ >= frame_size) {
     // We may have received more data then we need, only copy what we need
     size_t overage = received_ - frame_size;
     size_t needed = remaining - overage;
 
-    memcpy(body_buffer_pos_, input_pos, needed);
-    body_buffer_pos_ += needed;
+    if (body_buffer_pos_ == NULL && input_buffer != NULL &&
+        static_cast<size_t>(length_) * MIN_SHARED_BODY_FRACTION >= input_buffer->size()) {
+      // The whole body is in this input so it's decoded in place
+      response_body_->set_buffer(input_buffer, input_pos);
+    } else {
+      copy_body(input_pos, needed);
+      assert(body_buffer_pos_ == response_body_->data() + length_);
+    }
     input_pos += needed;
-    assert(body_buffer_pos_ == response_body_->data() + length_);
 
-    if (!response_body_->decode(version, response_body_->data(), length_)) {
+    size_t body_size = length_;
+    if ((flags_ & CASS_FLAG_COMPRESSION) && !decompress_body(&body_size)) {
+      is_body_error_ = true;
+      return -1;
+    }
+
+    char* body = response_body_->data();
+    if (!decode_body_prefix(&body, &body_size) ||
+        !response_body_->decode(version, body, body_size)) {
       is_body_error_ = true;
       return -1;
     }
@@ -130,8 +293,9 @@ int ResponseMessage::decode(int version, char* input, size_t size) {
   } else {
     // We haven't received all the data for the frame. We consume the entire
     // buffer.
-    memcpy(body_buffer_pos_, input_pos, remaining);
-    body_buffer_pos_ += remaining;
+    if (remaining > 0) {
+      copy_body(input_pos, remaining);
+    }
     return size;
   }
 
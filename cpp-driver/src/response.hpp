@@ -30,16 +30,25 @@ namespace cass {
 class Response {
 public:
   Response(uint8_t opcode)
-      : opcode_(opcode) {}
+      : opcode_(opcode)
+      , data_(NULL) {}
 
   virtual ~Response() {}
 
   uint8_t opcode() const { return opcode_; }
 
-  char* data() const { return buffer_->data(); }
+  char* data() const { return data_; }
   const SharedRefPtr<RefBuffer>& buffer() const { return buffer_; }
   void set_buffer(size_t size) {
     buffer_ = SharedRefPtr<RefBuffer>(RefBuffer::create(size));
+    data_ = buffer_->data();
+  }
+
+  // Use a slice of a buffer shared with other responses, such as the
+  // buffer a socket read went into, without copying it
+  void set_buffer(RefBuffer* buffer, char* data) {
+    buffer_ = SharedRefPtr<RefBuffer>(buffer);
+    data_ = data;
   }
 
   virtual bool decode(int version, char* buffer, size_t size) = 0;
@@ -47,6 +56,7 @@ public:
 private:
   uint8_t opcode_;
   SharedRefPtr<RefBuffer> buffer_;
+  char* data_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Response);
@@ -61,6 +71,7 @@ public:
       , opcode_(0)
       , length_(0)
       , received_(0)
+      , header_size_(CASS_HEADER_SIZE_V1_AND_V2)
       , is_header_received_(false)
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
@@ -69,27 +80,40 @@ public:
 
   uint8_t opcode() const { return opcode_; }
 
-  int8_t stream() const { return stream_; }
+  int16_t stream() const { return stream_; }
 
   ScopedPtr<Response>& response_body() { return response_body_; }
 
   bool is_body_ready() const { return is_body_ready_; }
 
-  int decode(int version, char* input, size_t size);
+  // If "input_buffer" holds the input, a body that's entirely contained
+  // in it references the buffer instead of being copied
+  int decode(int version, char* input, size_t size,
+             RefBuffer* input_buffer = NULL);
 
 private:
   bool allocate_body(int8_t opcode);
 
+  void copy_body(const char* input, size_t size);
+
+  // Replace an LZ4 compressed body with its uncompressed contents
+  bool decompress_body(size_t* size);
+
+  // Skip the tracing id, warnings and custom payload that may precede the
+  // body of the response, depending on the flags of the frame.
+  bool decode_body_prefix(char** body, size_t* size);
+
 private:
   uint8_t version_;
   int8_t flags_;
-  int8_t stream_;
+  int16_t stream_;
   uint8_t opcode_;
   int32_t length_;
   size_t received_;
 
+  size_t header_size_;
   bool is_header_received_;
-  char header_buffer_[CASS_HEADER_SIZE_V1_AND_V2];
+  char header_buffer_[CASS_HEADER_SIZE_V3];
   char* header_buffer_pos_;
 
   bool is_body_ready_;
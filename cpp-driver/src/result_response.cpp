@@ -83,7 +83,60 @@ size_t ResultResponse::find_column_indices(StringRef name,
   return metadata_->get(name, result);
 }
 
+// Skip the parameters of a type option that aren't kept in the column
+// definition: the element types of nested collections and the field types of
+// user types and tuples, which can appear starting with protocol v3.
+static char* skip_type_params(char* buffer, uint16_t type);
+
+static char* skip_option(char* buffer) {
+  uint16_t type;
+  char* class_name;
+  size_t class_name_size;
+  buffer = decode_option(buffer, type, &class_name, class_name_size);
+  return skip_type_params(buffer, type);
+}
+
+static char* skip_type_params(char* buffer, uint16_t type) {
+  switch (type) {
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_SET:
+      return skip_option(buffer);
+
+    case CASS_VALUE_TYPE_MAP:
+      return skip_option(skip_option(buffer));
+
+    case CQL_TYPE_UDT: {
+      // <keyspace> [string] + <name> [string] + <n> [short] +
+      // n * (<field_name> [string] + <field_type> [option])
+      StringRef ignored;
+      buffer = decode_string_ref(buffer, &ignored);
+      buffer = decode_string_ref(buffer, &ignored);
+      uint16_t count = 0;
+      buffer = decode_uint16(buffer, count);
+      for (uint16_t i = 0; i < count; ++i) {
+        buffer = decode_string_ref(buffer, &ignored);
+        buffer = skip_option(buffer);
+      }
+      return buffer;
+    }
+
+    case CQL_TYPE_TUPLE: {
+      // <n> [short] + n * <type> [option]
+      uint16_t count = 0;
+      buffer = decode_uint16(buffer, count);
+      for (uint16_t i = 0; i < count; ++i) {
+        buffer = skip_option(buffer);
+      }
+      return buffer;
+    }
+
+    default:
+      return buffer;
+  }
+}
+
 bool ResultResponse::decode(int version, char* input, size_t size) {
+  protocol_version_ = version;
   char* buffer = decode_int32(input, kind_);
 
   switch (kind_) {
@@ -104,7 +157,7 @@ bool ResultResponse::decode(int version, char* input, size_t size) {
       break;
 
     case CASS_RESULT_KIND_SCHEMA_CHANGE:
-      return decode_schema_change(buffer);
+      return decode_schema_change(version, buffer);
       break;
 
     default:
@@ -113,13 +166,21 @@ bool ResultResponse::decode(int version, char* input, size_t size) {
   return false;
 }
 
-char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<ResultMetadata>* metadata) {
+char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<ResultMetadata>* metadata,
+                                      bool has_pk_indices) {
   int32_t flags = 0;
   char* buffer = decode_int32(input, flags);
 
   int32_t column_count = 0;
   buffer = decode_int32(buffer, column_count);
 
+  if (has_pk_indices) {
+    // <pk_count> [int] + <pk_index_1>...<pk_index_n> [short]
+    int32_t pk_count = 0;
+    buffer = decode_int32(buffer, pk_count);
+    buffer += pk_count * sizeof(uint16_t);
+  }
+
   if (flags & CASS_RESULT_FLAG_HAS_MORE_PAGES) {
     has_more_pages_ = true;
     buffer = decode_bytes(buffer, &paging_state_, paging_state_size_);
@@ -157,12 +218,18 @@ char* ResultResponse::decode_metadata(char* input, ScopedRefPtr<ResultMetadata>*
         buffer = decode_option(buffer, def.collection_primary_type,
                                &def.collection_primary_class,
                                def.collection_primary_class_size);
+        buffer = skip_type_params(buffer, def.collection_primary_type);
       }
 
       if (def.type == CASS_VALUE_TYPE_MAP) {
         buffer = decode_option(buffer, def.collection_secondary_type,
                                &def.collection_secondary_class,
                                def.collection_secondary_class_size);
+        buffer = skip_type_params(buffer, def.collection_secondary_type);
+      }
+
+      if (def.type == CQL_TYPE_UDT || def.type == CQL_TYPE_TUPLE) {
+        buffer = skip_type_params(buffer, def.type);
       }
 
       (*metadata)->insert(def);
@@ -191,17 +258,30 @@ bool ResultResponse::decode_set_keyspace(char* input) {
 
 bool ResultResponse::decode_prepared(int version, char* input) {
   char* buffer = decode_string(input, &prepared_, prepared_size_);
-  buffer = decode_metadata(buffer, &metadata_);
+  // Protocol v4 adds the indices of the partition key columns
+  buffer = decode_metadata(buffer, &metadata_, version >= 4);
   if (version > 1) {
     decode_metadata(buffer, &result_metadata_);
   }
   return true;
 }
 
-bool ResultResponse::decode_schema_change(char* input) {
+bool ResultResponse::decode_schema_change(int version, char* input) {
   char* buffer = decode_string(input, &change_, change_size_);
-  buffer = decode_string(buffer, &keyspace_, keyspace_size_);
-  buffer = decode_string(buffer, &table_, table_size_);
+  if (version >= 3) {
+    // <target> [string] + <options>, where the options are the keyspace
+    // followed by the name of the table, type, function or aggregate unless
+    // the target is the keyspace itself. Only tables are kept.
+    StringRef target;
+    buffer = decode_string_ref(buffer, &target);
+    buffer = decode_string(buffer, &keyspace_, keyspace_size_);
+    if (target == "TABLE") {
+      decode_string(buffer, &table_, table_size_);
+    }
+  } else {
+    buffer = decode_string(buffer, &keyspace_, keyspace_size_);
+    decode_string(buffer, &table_, table_size_);
+  }
   return true;
 }
 
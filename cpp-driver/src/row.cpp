@@ -43,6 +43,14 @@ const CassValue* cass_row_get_column_by_name_n(const CassRow* row,
   return CassValue::to(row->get_by_name(cass::StringRef(name, name_length)));
 }
 
+CassRow* cass_row_copy(const CassRow* row) {
+  return CassRow::to(new cass::Row(*row));
+}
+
+void cass_row_free(CassRow* row) {
+  delete row->from();
+}
+
 } // extern "C"
 
 namespace cass {
@@ -61,9 +69,18 @@ char* decode_row(char* rows, const ResultResponse* result, ValueVec& output) {
     if (size >= 0) {
       if (type == CASS_VALUE_TYPE_MAP || type == CASS_VALUE_TYPE_LIST ||
           type == CASS_VALUE_TYPE_SET) {
-        uint16_t count = 0;
-        char* data = decode_uint16(buffer, count);
-        output.push_back(Value(&def, count, data, size - sizeof(uint16_t)));
+        // The number of elements is an [int] starting with protocol v3
+        int version = result->protocol_version();
+        int32_t count = 0;
+        char* data;
+        if (version >= 3) {
+          data = decode_int32(buffer, count);
+        } else {
+          uint16_t short_count = 0;
+          data = decode_uint16(buffer, short_count);
+          count = short_count;
+        }
+        output.push_back(Value(version, &def, count, data, size - (data - buffer)));
       } else {
         output.push_back(Value(type, buffer, size));
       }
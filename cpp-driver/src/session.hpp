@@ -17,6 +17,7 @@
 #ifndef __CASS_SESSION_HPP_INCLUDED__
 #define __CASS_SESSION_HPP_INCLUDED__
 
+#include "buffer_pool.hpp"
 #include "cluster_metadata.hpp"
 #include "config.hpp"
 #include "control_connection.hpp"
@@ -79,6 +80,7 @@ public:
 
   const Config& config() const { return config_; }
   Metrics* metrics() const { return metrics_.get(); }
+  BufferPool* buffer_pool() { return &buffer_pool_; }
 
   void set_load_balancing_policy(LoadBalancingPolicy* policy) {
     load_balancing_policy_.reset(policy);
@@ -160,6 +162,7 @@ private:
 
   Config config_;
   ScopedPtr<Metrics> metrics_;
+  BufferPool buffer_pool_; // Used by the control connection
   ScopedRefPtr<LoadBalancingPolicy> load_balancing_policy_;
   ScopedRefPtr<Future> connect_future_;
   ScopedRefPtr<Future> close_future_;
@@ -21,39 +21,87 @@
 
 #include <uv.h>
 
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace cass {
 
+inline int count_trailing_zeros(uint64_t word) {
+  assert(word != 0);
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, word);
+  return static_cast<int>(index);
+#elif defined(_MSC_VER)
+  unsigned long index;
+  if (_BitScanForward(&index, static_cast<uint32_t>(word))) {
+    return static_cast<int>(index);
+  }
+  _BitScanForward(&index, static_cast<uint32_t>(word >> 32));
+  return static_cast<int>(index) + 32;
+#else
+  return __builtin_ctzll(word);
+#endif
+}
+
+// Allocates stream ids with a bitmap in which a set bit marks a free stream,
+// so a free stream is found one 64 bit word at a time. The items are kept
+// in a dense array indexed by stream.
+//
+// The search for a free stream starts at the word after the one the last
+// stream came from. This spreads the streams in use over the whole range
+// instead of always reusing the lowest ids.
 template <class T>
 class StreamManager {
 public:
-  static const int MAX_STREAMS = 128;
-
-  StreamManager()
-      : available_stream_index_(0) {
-    for (int i = 0; i < MAX_STREAMS; ++i) {
-      available_streams_[i] = i;
-      allocated_streams_[i] = false;
-    }
-  }
-
-  int8_t acquire_stream(const T& item) {
-    if (available_stream_index_ >= MAX_STREAMS) {
+  // Protocol v1 and v2 stream ids are a [byte], v3 and later a [short].
+  // Negative ids are reserved for server events.
+  static const int MAX_STREAMS_V1_AND_V2 = 128;
+  static const int MAX_STREAMS_V3 = 32768;
+
+  StreamManager(int protocol_version)
+      : max_streams_(protocol_version >= 3 ? MAX_STREAMS_V3
+                                           : MAX_STREAMS_V1_AND_V2)
+      , num_words_(max_streams_ / BITS_PER_WORD)
+      , offset_(0)
+      , pending_(0)
+      , words_(num_words_, ~static_cast<uint64_t>(0))
+      , items_(max_streams_) {}
+
+  int max_streams() const { return max_streams_; }
+
+  int16_t acquire_stream(const T& item) {
+    if (pending_ >= max_streams_) {
       return -1;
     }
-    int8_t stream = available_streams_[available_stream_index_++];
-    items_[stream] = item;
-    allocated_streams_[stream] = true;
-    return stream;
+    for (size_t i = 0; i < num_words_; ++i) {
+      size_t index = (offset_ + i) & (num_words_ - 1);
+      uint64_t word = words_[index];
+      if (word != 0) {
+        words_[index] = word & (word - 1); // Clear the lowest set bit
+        offset_ = index + 1;
+        ++pending_;
+        int16_t stream = static_cast<int16_t>(index * BITS_PER_WORD +
+                                              count_trailing_zeros(word));
+        items_[stream] = item;
+        return stream;
+      }
+    }
+    assert(false && "No free stream found while some are available");
+    return -1;
   }
 
-  void release_stream(int8_t stream) {
-    assert(allocated_streams_[stream]);
-    available_streams_[--available_stream_index_] = stream;
-    allocated_streams_[stream] = false;
+  void release_stream(int16_t stream) {
+    assert(is_allocated(stream));
+    words_[stream / BITS_PER_WORD] |= bit(stream);
+    --pending_;
   }
 
-  bool get_item(int8_t stream, T& output, bool release = true) {
-    if (allocated_streams_[stream]) {
+  bool get_item(int16_t stream, T& output, bool release = true) {
+    if (stream >= 0 && stream < max_streams_ && is_allocated(stream)) {
       output = items_[stream];
       if (release) {
         release_stream(stream);
@@ -63,14 +111,26 @@ public:
     return false;
   }
 
-  size_t available_streams() const { return MAX_STREAMS - available_stream_index_; }
-  size_t pending_streams() const { return available_stream_index_; }
+  size_t available_streams() const { return max_streams_ - pending_; }
+  size_t pending_streams() const { return pending_; }
 
 private:
-  int available_stream_index_;
-  int8_t available_streams_[MAX_STREAMS];
-  bool allocated_streams_[MAX_STREAMS];
-  T items_[MAX_STREAMS];
+  static const int BITS_PER_WORD = 64;
+
+  static uint64_t bit(int16_t stream) {
+    return static_cast<uint64_t>(1) << (stream % BITS_PER_WORD);
+  }
+
+  bool is_allocated(int16_t stream) const {
+    return (words_[stream / BITS_PER_WORD] & bit(stream)) == 0;
+  }
+
+  const int max_streams_;
+  const size_t num_words_; // A power of two
+  size_t offset_;
+  int pending_;
+  std::vector<uint64_t> words_;
+  std::vector<T> items_;
 };
 
 } // namespace cass
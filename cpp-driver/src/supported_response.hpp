@@ -32,6 +32,8 @@ public:
 
   bool decode(int version, char* buffer, size_t size);
 
+  const std::list<std::string>& compression() const { return compression_; }
+
 private:
   std::list<std::string> compression_;
   std::list<std::string> versions_;
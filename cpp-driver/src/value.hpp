@@ -20,6 +20,7 @@
 #include "cassandra.h"
 #include "buffer_piece.hpp"
 #include "result_metadata.hpp"
+#include "serialization.hpp"
 
 namespace cass {
 
@@ -29,28 +30,33 @@ public:
       : type_(CASS_VALUE_TYPE_UNKNOWN)
       , primary_type_(CASS_VALUE_TYPE_UNKNOWN)
       , secondary_type_(CASS_VALUE_TYPE_UNKNOWN)
-      , count_(0) {}
+      , count_(0)
+      , protocol_version_(0) {}
 
   Value(CassValueType type, char* data, size_t size)
       : type_(type)
       , primary_type_(CASS_VALUE_TYPE_UNKNOWN)
       , secondary_type_(CASS_VALUE_TYPE_UNKNOWN)
       , count_(0)
+      , protocol_version_(0)
       , buffer_(data, size) {}
 
-  Value(CassValueType type, CassValueType primary_type, CassValueType secondary_type,
-        int32_t count, char* data, size_t size)
+  Value(int protocol_version, CassValueType type, CassValueType primary_type,
+        CassValueType secondary_type, int32_t count, char* data, size_t size)
       : type_(type)
       , primary_type_(primary_type)
       , secondary_type_(secondary_type)
       , count_(count)
+      , protocol_version_(protocol_version)
       , buffer_(data, size) {}
 
-  Value(const ColumnDefinition* def, int32_t count, char* data, size_t size)
+  Value(int protocol_version, const ColumnDefinition* def, int32_t count,
+        char* data, size_t size)
     : type_(static_cast<CassValueType>(def->type))
     , primary_type_(static_cast<CassValueType>(def->collection_primary_type))
     , secondary_type_(static_cast<CassValueType>(def->collection_secondary_type))
     , count_(count)
+    , protocol_version_(protocol_version)
     , buffer_(data, size) {}
 
   CassValueType type() const { return type_; }
@@ -74,6 +80,18 @@ public:
     return count_;
   }
 
+  // Decode the size of an element of a collection, which is a [short]
+  // before protocol v3 and an [int] since.
+  char* decode_element_size(char* position, int32_t* size) const {
+    if (protocol_version_ >= 3) {
+      return decode_int32(position, *size);
+    }
+    uint16_t short_size = 0;
+    position = decode_uint16(position, short_size);
+    *size = short_size;
+    return position;
+  }
+
   const BufferPiece& buffer() const {
     return buffer_;
   }
@@ -83,6 +101,7 @@ private:
   CassValueType primary_type_;
   CassValueType secondary_type_;
   int32_t count_;
+  int protocol_version_;
   BufferPiece buffer_;
 };
 
@@ -28,6 +28,9 @@ module.exports = {
         CASS_VALUE_TYPE_SET: 0x0022
     },
     encodings: {
-        BIGINT_AS_OBJECT: 0x01 << 16
+        BIGINT_AS_OBJECT: 0x01 << 16,
+        BLOB_ZERO_COPY: 0x02 << 16,
+        BIGINT_AS_BIGINT: 0x03 << 16,
+        STRING_INTERN: 0x04 << 16
     }
 };
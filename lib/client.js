@@ -1,9 +1,40 @@
 var addon = require('./addon');
+var stream = require('stream');
+var util = require('util');
 
 var debug = require('debug')('cassandra');
 
 function Client(options) {
-    this.client = new addon.Client(options || {});
+    options = options || {};
+    this.client = new addon.Client(options);
+    if (options.batchCallbacks) {
+        this.client.set_dispatcher(dispatch);
+    }
+}
+
+// Trampoline for batched callback delivery. The addon passes all the
+// callbacks that completed in one turn of the event loop as a flat array of
+// (callback, err, result) triples.
+//
+// An exception thrown by one callback doesn't prevent the others from being
+// called. The first one is rethrown once all of them have run.
+function dispatch(queue) {
+    var error;
+    var threw = false;
+    for (var i = 0; i < queue.length; i += 3) {
+        try {
+            queue[i](queue[i + 1], queue[i + 2]);
+        } catch (err) {
+            if (!threw) {
+                error = err;
+                threw = true;
+            }
+        }
+    }
+
+    if (threw) {
+        throw error;
+    }
 }
 
 Client.prototype.connect = function(options, cb) {
@@ -63,6 +94,13 @@ Client.prototype._execute = function(query, params, options, callback, endCallba
             rows: data.rows
         };
 
+        if (data.columns) {
+            result.columns = data.columns;
+        }
+        if (data.values) {
+            result.values = data.values;
+        }
+
         if (data.more) {
             result.pageState = q;
         }
@@ -76,6 +114,30 @@ Client.prototype._execute = function(query, params, options, callback, endCallba
         }
     }
 
+    // Bind and execute a query from the cached prepared statement
+    function executePrepared(prepared) {
+        q = prepared.query();
+        q.query = query;
+
+        debug('calling bind', query, params, options);
+        q.bind(params, options);
+
+        debug('calling execute', options);
+        q.execute(options, pageCallback);
+    }
+
+    // When paging automatically the next page is always wanted, so request
+    // it while the current one is being processed. This is set on a copy so
+    // the caller's options are left alone.
+    if (options.autoPage && options.prefetch === undefined) {
+        var copy = {};
+        for (var key in options) {
+            copy[key] = options[key];
+        }
+        copy.prefetch = true;
+        options = copy;
+    }
+
     // Handle manual pageState in which the query object is passed in from the
     // application as options.pageState.
     if (options.pageState) {
@@ -84,6 +146,30 @@ Client.prototype._execute = function(query, params, options, callback, endCallba
             throw new Error('pageState mismatch: query ' + query + ' != bound ' + q.query);
         }
         delete options.pageState;
+
+        // A prepared query is still bound to the same params so it just
+        // continues where it left off.
+        if (options.prepare) {
+            debug('calling execute', options);
+            q.execute(options, pageCallback);
+            return q;
+        }
+    } else if (options.prepare) {
+        // The cached prepared statement is returned right away, otherwise the
+        // callback is called once it has been prepared.
+        var prepared = this.client.prepare_cached(query, function(err, prepared) {
+            if (err) { return endCallback(err); }
+            try {
+                executePrepared(prepared);
+            } catch (err) {
+                endCallback(err);
+            }
+        });
+
+        if (prepared) {
+            executePrepared(prepared);
+        }
+        return q;
     } else {
         q = this.client.new_query();
     }
@@ -97,6 +183,37 @@ Client.prototype._execute = function(query, params, options, callback, endCallba
     return q;
 };
 
+// Join the per-page column values of a columnar result into a single array
+// (or typed array) per column.
+function joinColumns(pages) {
+    if (pages.length === 1) {
+        return pages[0];
+    }
+
+    return pages[0].map(function(first, i) {
+        var chunks = pages.map(function(page) { return page[i]; });
+        var ctor = first.constructor;
+        var packed = ctor !== Array && chunks.every(function(chunk) {
+            return chunk.constructor === ctor;
+        });
+
+        if (packed) {
+            var length = chunks.reduce(function(sum, chunk) { return sum + chunk.length; }, 0);
+            var column = new ctor(length);
+            var offset = 0;
+            chunks.forEach(function(chunk) {
+                column.set(chunk, offset);
+                offset += chunk.length;
+            });
+            return column;
+        }
+
+        return Array.prototype.concat.apply([], chunks.map(function(chunk) {
+            return Array.prototype.slice.call(chunk);
+        }));
+    });
+}
+
 // Execute the given query and return all the results.
 //
 // * query: (required) CQL query string
@@ -106,17 +223,35 @@ Client.prototype._execute = function(query, params, options, callback, endCallba
 Client.prototype.execute = function(query, params, options, callback) {
     var args = parseArgs(query, params, options, callback);
 
-    var data = {
-        rows: []
-    };
+    var data = {};
+    var pages = [];
+
+    if (args.options.rowMode === 'columnar') {
+        data.columns = [];
+    } else {
+        data.rows = [];
+    }
 
     function pageCallback(results) {
-        data.rows = data.rows.concat(results.rows);
+        if (results.values) {
+            data.columns = results.columns;
+            pages.push(results.values);
+        } else {
+            data.rows = data.rows.concat(results.rows);
+            if (results.columns) {
+                data.columns = results.columns;
+            }
+        }
         data.pageState = results.pageState;
     }
 
     function endCallback(err) {
         if (err) { return args.callback(err); }
+        if (pages.length !== 0) {
+            data.values = joinColumns(pages);
+        } else if (args.options.rowMode === 'columnar') {
+            data.values = [];
+        }
         args.callback(null, data);
     }
     this._execute(args.query, args.params, args.options, pageCallback, endCallback);
@@ -133,6 +268,10 @@ Client.prototype.execute = function(query, params, options, callback) {
 Client.prototype.eachRow = function(query, params, options, rowCallback, endCallback) {
     var args = parseArgs(query, params, options, rowCallback, endCallback);
 
+    if (args.options.rowMode === 'columnar') {
+        throw new Error('eachRow does not support rowMode columnar');
+    }
+
     function pageCallback(results) {
         results.rows.forEach(function(row) {
             args.callback(row);
@@ -142,6 +281,111 @@ Client.prototype.eachRow = function(query, params, options, rowCallback, endCall
     this._execute(args.query, args.params, args.options, pageCallback, endCallback);
 };
 
+// Readable object stream of the rows returned by a query.
+//
+// Pages are fetched one at a time and only once the consumer has drained the
+// buffered rows below the high water mark, so scanning a large result takes
+// a bounded amount of memory no matter how slow the consumer is.
+function RowStream(client, query, params, options) {
+    stream.Readable.call(this, {
+        objectMode: true,
+        highWaterMark: options.highWaterMark || options.fetchSize || 5000
+    });
+
+    this._client = client;
+    this._query = query;
+    this._params = params;
+    this._options = options;
+    this._pageState = null;
+    this._fetching = false;
+    this._started = false;
+}
+util.inherits(RowStream, stream.Readable);
+
+RowStream.prototype._read = function() {
+    if (this._fetching) {
+        return;
+    }
+    this._fetching = true;
+
+    var self = this;
+    var rows = [];
+
+    function done(err, more) {
+        self._fetching = false;
+        if (self.destroyed) { return; }
+        if (err) { return self.emit('error', err); }
+
+        if (!more) {
+            self._pageState = null;
+        }
+
+        rows.forEach(function(row) {
+            self.push(row);
+        });
+
+        if (!self._pageState) {
+            self.push(null);
+        } else if (rows.length === 0) {
+            // Nothing was pushed so the stream won't ask for more
+            self._read();
+        }
+    }
+
+    // The first page goes through the usual query path, after which the
+    // query object is executed again to continue from where it left off.
+    if (!this._started) {
+        this._started = true;
+        this._client._execute(this._query, this._params, this._options,
+            function(results) {
+                rows = results.rows;
+            },
+            function(err, result) {
+                if (!err) {
+                    self._pageState = result.pageState;
+                }
+                done(err, !!self._pageState);
+            });
+        return;
+    }
+
+    debug('stream: calling execute', this._options);
+    this._pageState.execute(this._options, function(err, data) {
+        if (!err) {
+            rows = data.rows;
+        }
+        done(err, !err && data.more);
+    });
+};
+
+// Execute the given query and return a readable stream of the rows. The
+// stream can also be consumed as an async iterator where supported.
+//
+// * query: (required) CQL query string
+// * params: (optional) data to bind to the query
+// * options: (optional) options for the query
+Client.prototype.stream = function(query, params, options) {
+    if (!(params instanceof Array)) {
+        options = params;
+        params = [];
+    }
+    options = options || {};
+
+    if (query === undefined) {
+        throw new Error('query is required');
+    }
+
+    if (options.rowMode === 'columnar') {
+        throw new Error('stream does not support rowMode columnar');
+    }
+
+    if (options.autoPage || options.prefetch) {
+        throw new Error('stream does not support autoPage or prefetch');
+    }
+
+    return new RowStream(this, query, params, options);
+};
+
 Client.prototype.new_query = function(query, callback) {
     return this.client.new_query();
 };
@@ -151,10 +395,36 @@ Client.prototype.prepare = function(query, callback) {
     return p.prepare(query, callback);
 };
 
+// Execute the given prepared query once for each set of params, keeping up
+// to options.concurrency requests in flight.
+//
+// * prepared: (required) prepared query
+// * params: (required) array of arrays of data to bind to the query
+// * options: (optional) options for the queries
+// * callback: (required) callback function
+Client.prototype.executeMany = function(prepared, params, options, callback) {
+    if (typeof options === 'function') {
+        callback = options;
+        options = {};
+    }
+
+    if (!prepared || !params || !callback) {
+        throw new Error('prepared, params and callback are required');
+    }
+
+    var q = this.client.new_bulk_query();
+    q.execute(prepared, params, options, callback);
+};
+
 Client.prototype.new_batch = function(type) {
     return this.client.new_batch(type);
 };
 
+// Drop the statements cached for the prepare option of execute
+Client.prototype.clearPreparedCache = function() {
+    this.client.clear_prepared_cache();
+};
+
 Client.prototype.metrics = function(reset) {
     return this.client.metrics(reset);
 };
@@ -20,6 +20,10 @@ if (mode === "prepared") {
     prepared = true;
     batch = false;
 }
+else if (mode === "many") {
+    prepared = true;
+    batch = false;
+}
 else if (mode === "batch") {
     prepared = true;
     batch = parseInt(process.argv[5]);
@@ -76,6 +80,8 @@ client.connect({contactPoints: '127.0.0.1'})
     start = new Date();
     if (batch) {
         return client.insertRowsPreparedBatch(table, data, {concurrency: concurrency, batch_size: batch});
+    } else if (mode === "many") {
+        return client.insertRowsMany(table, data, {concurrency: concurrency});
     } else if (prepared) {
         return client.insertRowsPrepared(table, data, {concurrency: concurrency});
     } else {
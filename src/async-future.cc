@@ -1,12 +1,18 @@
 #include "async-future.h"
-#include <sys/time.h>
 #include "metrics.h"
 
+AsyncFuture* AsyncFuture::dispatching_ = NULL;
+
 AsyncFuture::AsyncFuture(Metrics* metrics)
 {
     metrics_ = metrics;
-
-    uv_mutex_init(&lock_);
+    ready_ = NULL;
+    backlog_ = NULL;
+    free_ = NULL;
+    drain_count_budget_ = 0;
+    drain_time_budget_ = 0;
+    dispatcher_ = NULL;
+    dispatch_length_ = 0;
 
     async_ = new uv_async_t();
     uv_async_init(uv_default_loop(), async_, on_async_ready);
@@ -22,33 +28,131 @@ async_destroy(uv_handle_t* handle)
 
 AsyncFuture::~AsyncFuture()
 {
-    uv_mutex_destroy(&lock_);
+    delete dispatcher_;
+    dispatch_queue_.Reset();
+
+    while (free_) {
+        Pending* pending = free_;
+        free_ = pending->next_;
+        delete pending;
+    }
 
     uv_handle_t* async_handle = (uv_handle_t*)async_;
     uv_close(async_handle, async_destroy);
 }
 
+AsyncFuture::Pending*
+AsyncFuture::new_pending(callback_t callback, void* client, void* data,
+                         callback_t prepare)
+{
+    Pending* pending = free_;
+    if (pending) {
+        free_ = pending->next_;
+    } else {
+        pending = new Pending();
+    }
+
+    pending->owner_ = this;
+    pending->callback_ = callback;
+    pending->prepare_ = prepare;
+    pending->future_ = NULL;
+    pending->client_ = client;
+    pending->data_ = data;
+    pending->next_ = NULL;
+    return pending;
+}
+
 void
-AsyncFuture::schedule(callback_t callback, CassFuture* future, void* client, void* data)
+AsyncFuture::schedule(callback_t callback, CassFuture* future, void* client, void* data,
+                      callback_t prepare)
 {
-    Pending* pending = new Pending(this, callback, client, data);
+    Pending* pending = new_pending(callback, client, data, prepare);
     cass_future_set_callback(future, on_future_ready, pending);
 }
 
+void
+AsyncFuture::defer(callback_t callback, void* client, void* data)
+{
+    future_ready(NULL, new_pending(callback, client, data, NULL));
+}
+
+void
+AsyncFuture::set_dispatcher(v8::Local<v8::Function> dispatcher)
+{
+    delete dispatcher_;
+    dispatcher_ = NULL;
+    if (! dispatcher.IsEmpty()) {
+        dispatcher_ = new Nan::Callback(dispatcher);
+    }
+}
+
+void
+AsyncFuture::call(Nan::Callback* callback, int argc, v8::Local<v8::Value> argv[])
+{
+    AsyncFuture* self = dispatching_;
+    if (self == NULL) {
+        callback->Call(argc, argv);
+        return;
+    }
+
+    Nan::HandleScope scope;
+
+    if (self->dispatch_queue_.IsEmpty()) {
+        self->dispatch_queue_.Reset(Nan::New<v8::Array>());
+    }
+    v8::Local<v8::Array> queue = Nan::New(self->dispatch_queue_);
+
+    Nan::Set(queue, self->dispatch_length_++, callback->GetFunction());
+    for (int i = 0; i < 2; ++i) {
+        if (i < argc) {
+            Nan::Set(queue, self->dispatch_length_++, argv[i]);
+        } else {
+            Nan::Set(queue, self->dispatch_length_++, Nan::Undefined());
+        }
+    }
+}
+
+void
+AsyncFuture::dispatch()
+{
+    if (dispatch_length_ == 0) {
+        return;
+    }
+
+    Nan::HandleScope scope;
+
+    v8::Local<v8::Value> argv[] = {
+        Nan::New(dispatch_queue_)
+    };
+    dispatch_queue_.Reset();
+    dispatch_length_ = 0;
+
+    dispatcher_->Call(1, argv);
+}
+
 void
 AsyncFuture::on_future_ready(CassFuture* future, void* data)
 {
     Pending* pending = (Pending*)data;
+    if (pending->prepare_) {
+        pending->prepare_(future, pending->client_, pending->data_);
+    }
     pending->owner_->future_ready(future, pending);
 }
 
 void
 AsyncFuture::future_ready(CassFuture* future, Pending* pending)
 {
-    uv_mutex_lock(&lock_);
     pending->future_ = future;
-    queue_.push(pending);
-    uv_mutex_unlock(&lock_);
+
+    // The compare and swap is a full barrier so the main thread sees the
+    // completed wrapper once it is linked in.
+    Pending* head;
+    do {
+        head = ready_;
+        pending->next_ = head;
+    } while (! __sync_bool_compare_and_swap(&ready_, head, pending));
+
     uv_async_send(async_);
 }
 
@@ -63,47 +167,78 @@ AsyncFuture::on_async_ready(uv_async_t* handle)
     self->async_ready();
 }
 
-uint32_t
-timeval_diff_us(const struct timeval &start, const struct timeval &end)
+bool
+AsyncFuture::take_ready()
 {
-    return ((end.tv_sec - start.tv_sec) * 1000000) +
-           ((end.tv_usec - start.tv_usec));
+    // Take everything that has completed so far (with acquire semantics)
+    Pending* stack = __sync_lock_test_and_set(&ready_, (Pending*)NULL);
+    if (stack == NULL) {
+        return false;
+    }
+
+    // The stack is in reverse completion order so flip it around
+    while (stack) {
+        Pending* next = stack->next_;
+        stack->next_ = backlog_;
+        backlog_ = stack;
+        stack = next;
+    }
+    return true;
 }
 
 void
 AsyncFuture::async_ready()
 {
-    uv_mutex_lock(&lock_);
-    if (queue_.empty()) {
-        uv_mutex_unlock(&lock_);
-        return;
+    uint64_t start = uv_hrtime();
+    uint64_t deadline = 0;
+    if (drain_time_budget_) {
+        deadline = start + (uint64_t)drain_time_budget_ * 1000;
     }
 
-    std::queue<Pending*> ready_queue;
-    std::swap(queue_, ready_queue);
-    uv_mutex_unlock(&lock_);
+    // With a dispatcher, all the callbacks run by this drain are collected
+    // and delivered in a single call into Javascript at the end.
+    if (dispatcher_) {
+        dispatching_ = this;
+    }
 
-    uint32_t count = 0;
-    struct timeval start, end;
-    uint32_t elapsed;
+    // Without a budget only what had completed when the drain started is
+    // processed, so a steady stream of completions can't keep the loop here.
+    // Anything completing meanwhile has already signalled the next wakeup.
+    if (backlog_ == NULL) {
+        take_ready();
+    }
+    bool budgeted = drain_count_budget_ || deadline;
 
-    ::gettimeofday(&start, 0);
-    while (! ready_queue.empty()) {
-        Pending* pending = ready_queue.front();
-        ready_queue.pop();
+    uint32_t count = 0;
+    while (backlog_ || (budgeted && take_ready())) {
+        if ((drain_count_budget_ && count >= drain_count_budget_) ||
+            (deadline && uv_hrtime() >= deadline))
+        {
+            // Leave the rest for a later turn of the event loop so that
+            // timers and other I/O are serviced in between.
+            metrics_->response_queue_drain_deferred_count_++;
+            uv_async_send(async_);
+            break;
+        }
+
+        Pending* pending = backlog_;
+        backlog_ = pending->next_;
         pending->callback_(pending->future_, pending->client_, pending->data_);
-        delete pending;
+
+        pending->next_ = free_;
+        free_ = pending;
         count++;
     }
 
-    ::gettimeofday(&end, 0);
-    elapsed = timeval_diff_us(start, end);
-
-    if (count > metrics_->response_queue_drain_count_max_) {
-        metrics_->response_queue_drain_count_max_ = count;
+    if (dispatching_) {
+        dispatching_ = NULL;
+        dispatch();
     }
 
-    if (elapsed > metrics_->response_queue_drain_time_max_) {
-        metrics_->response_queue_drain_time_max_ = elapsed;
+    if (count == 0) {
+        return;
     }
+
+    uint32_t elapsed = (uint32_t)((uv_hrtime() - start) / 1000);
+    metrics_->record_drain(count, elapsed);
 }
@@ -1,6 +1,9 @@
+#ifndef __CASS_DRIVER_ASYNC_FUTURE_H__
+#define __CASS_DRIVER_ASYNC_FUTURE_H__
+
 #include "cassandra.h"
+#include "nan.h"
 #include <uv.h>
-#include <queue>
 
 class Metrics;
 
@@ -15,25 +18,79 @@ public:
     typedef void(*callback_t)(CassFuture* future, void* client, void* data);
 
     // Schedule a callback when the given future is ready.
-    void schedule(callback_t callback, CassFuture* future, void* client, void* data);
+    //
+    // If given, the prepare function is first called on the driver thread
+    // that completed the future, before the callback is queued for the main
+    // thread. It must not touch any v8 state.
+    void schedule(callback_t callback, CassFuture* future, void* client, void* data,
+                  callback_t prepare = NULL);
+
+    // Queue a callback (with a NULL future) to run on a later turn of the
+    // event loop, along with the completed operations. Must be called on the
+    // main thread.
+    void defer(callback_t callback, void* client, void* data);
+
+    // Limit the number of callbacks run (or the time in microseconds spent)
+    // each time the completed operations are drained on the main thread. Any
+    // remaining operations are handled on a later turn of the event loop. A
+    // budget of zero means no limit.
+    void set_drain_count_budget(uint32_t count) { drain_count_budget_ = count; }
+    void set_drain_time_budget(uint32_t time) { drain_time_budget_ = time; }
+
+    // Set (or clear, given an empty handle) a function that receives all the
+    // callbacks of a drain in one call instead of each callback being called
+    // separately. The function is passed an array of (callback, err, result)
+    // triples and is responsible for calling each callback in turn.
+    void set_dispatcher(v8::Local<v8::Function> dispatcher);
+
+    // Call the given completion callback, or queue it for the dispatcher if
+    // there is one for the drain in progress.
+    static void call(Nan::Callback* callback, int argc, v8::Local<v8::Value> argv[]);
 
 private:
-    // Wrapper for a pending future operation
+    // Wrapper for a pending future operation. The next_ link is used both
+    // for the list of completed operations and for the free list.
     struct Pending {
-        Pending(AsyncFuture* o, callback_t cb, void* c, void* d)
-            : owner_(o), callback_(cb), future_(NULL), client_(c), data_(d) {}
-
         AsyncFuture* owner_;
         callback_t callback_;
+        callback_t prepare_;
         CassFuture* future_;
         void* client_;
         void* data_;
+        Pending* next_;
     };
 
     Metrics* metrics_;
-    uv_mutex_t lock_;
     uv_async_t* async_;
-    std::queue<Pending*> queue_;
+
+    // Stack of completed operations, pushed by the driver threads with a
+    // compare and swap and taken all at once by the main thread. Since there
+    // is only a single consumer that never pops individual entries there is
+    // no ABA problem.
+    Pending* volatile ready_;
+
+    // Completed operations in completion order that have been taken off the
+    // stack but not yet handled. Only touched on the main thread.
+    Pending* backlog_;
+
+    uint32_t drain_count_budget_;
+    uint32_t drain_time_budget_;
+
+    // Dispatcher function and the callbacks queued for it during a drain
+    Nan::Callback* dispatcher_;
+    Nan::Persistent<v8::Array> dispatch_queue_;
+    uint32_t dispatch_length_;
+
+    // The instance whose drain (with a dispatcher) is in progress, if any
+    static AsyncFuture* dispatching_;
+
+    // Pending wrappers available for reuse. Only touched on the main thread,
+    // which is where operations are both scheduled and retired.
+    Pending* free_;
+
+    // Take a wrapper from the free list (or allocate one)
+    Pending* new_pending(callback_t callback, void* client, void* data,
+                         callback_t prepare);
 
     // Notification on the worker thread when a future is ready
     static void on_future_ready(CassFuture* future, void* data);
@@ -46,4 +103,13 @@ private:
     static void on_async_ready(uv_async_t* handle);
 #endif
     void async_ready();
+
+    // Move the completed operations from the stack to the (empty) backlog,
+    // returning false if there were none.
+    bool take_ready();
+
+    // Hand the callbacks queued during the drain to the dispatcher
+    void dispatch();
 };
+
+#endif
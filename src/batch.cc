@@ -2,6 +2,7 @@
 
 #include "batch.h"
 #include "client.h"
+#include "column-binder.h"
 #include "persistent-string.h"
 #include "prepared-query.h"
 #include "query.h"
@@ -23,6 +24,7 @@ void Batch::Init() {
 
     Nan::SetPrototypeMethod(tpl, "add", WRAPPED_METHOD_NAME(AddQuery));
     Nan::SetPrototypeMethod(tpl, "add_prepared", WRAPPED_METHOD_NAME(AddPrepared));
+    Nan::SetPrototypeMethod(tpl, "add_prepared_columns", WRAPPED_METHOD_NAME(AddPreparedColumns));
     Nan::SetPrototypeMethod(tpl, "execute", WRAPPED_METHOD_NAME(Execute));
 
     constructor.Reset(tpl->GetFunction());
@@ -130,7 +132,7 @@ WRAPPED_METHOD(Batch, AddPrepared)
     }
 
     CassStatement* statement = prepared->prepare_statement();
-    int bindingStatus = TypeMapper::bind_statement_params(statement, params, param_types);
+    int bindingStatus = prepared->bind(statement, params, param_types);
 
     if (bindingStatus != -1) {
         char err[1024];
@@ -144,6 +146,67 @@ WRAPPED_METHOD(Batch, AddPrepared)
     return;
 }
 
+WRAPPED_METHOD(Batch, AddPreparedColumns)
+{
+    if (info.Length() < 2) {
+        return Nan::ThrowError("add_prepared_columns requires prepared and columns");
+    }
+
+    Local<Object> prepared_obj = info[0].As<Object>();
+    if (! prepared_obj->IsObject() || prepared_obj->InternalFieldCount() == 0) {
+        return Nan::ThrowError("add_prepared_columns requires a valid prepared object");
+    }
+
+    if (! info[1]->IsArray()) {
+        return Nan::ThrowError("add_prepared_columns requires columns to be an array");
+    }
+
+    PreparedQuery* prepared = Nan::ObjectWrap::Unwrap<PreparedQuery>(prepared_obj->ToObject());
+    Local<Array> columns = info[1].As<Array>();
+    int64_t row_count = -1;
+    std::string error;
+
+    if (info.Length() > 2) {
+        Local<Object> options = info[2].As<Object>();
+        if (! ColumnBinder::row_count_option(options, &row_count, &error)) {
+            return Nan::ThrowError(error.c_str());
+        }
+    }
+
+    ColumnBinder binder;
+    if (! binder.init(prepared, columns, row_count, &error)) {
+        return Nan::ThrowError(error.c_str());
+    }
+
+    // Bind every row before adding any of them, so that a row that fails
+    // leaves the batch as it was
+    std::vector<CassStatement*> statements;
+    statements.reserve(binder.row_count());
+    for (size_t i = 0; i < binder.row_count(); ++i) {
+        CassStatement* statement = prepared->prepare_statement();
+        statements.push_back(statement);
+
+        int bindingStatus = binder.bind(statement, i);
+        if (bindingStatus != -1) {
+            for (size_t j = 0; j < statements.size(); ++j) {
+                cass_statement_free(statements[j]);
+            }
+
+            char err[1024];
+            sprintf(err, "error binding row %u statement argument %d",
+                    (unsigned)i, bindingStatus);
+            return Nan::ThrowError(err);
+        }
+    }
+
+    for (size_t i = 0; i < statements.size(); ++i) {
+        cass_batch_add_statement(batch_, statements[i]);
+        cass_statement_free(statements[i]);
+    }
+
+    return;
+}
+
 WRAPPED_METHOD(Batch, Execute)
 {
     Nan::HandleScope scope;
@@ -170,9 +233,7 @@ WRAPPED_METHOD(Batch, Execute)
 
     Nan::Callback* callback = new Nan::Callback(info[1].As<Function>());
 
-    if (result_.result()) {
-        cass_result_free(result_.result());
-    }
+    result_.release_result();
 
     CassFuture* future = cass_session_execute_batch(session_, batch_);
     metrics_->start_request();
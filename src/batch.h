@@ -39,6 +39,10 @@ private:
     // Add a prepared query to the batch
     WRAPPED_METHOD_DECL(AddPrepared);
 
+    // Add a prepared query to the batch once for each row of a set of
+    // columns (see ColumnBinder)
+    WRAPPED_METHOD_DECL(AddPreparedColumns);
+
     // Execute the batch
     WRAPPED_METHOD_DECL(Execute);
 
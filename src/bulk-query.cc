@@ -0,0 +1,327 @@
+#include <cassandra.h>
+#include <stdint.h>
+
+#include "bulk-query.h"
+#include "client.h"
+#include "column-binder.h"
+#include "persistent-string.h"
+#include "prepared-query.h"
+#include "metrics.h"
+#include "type-mapper.h"
+
+Nan::Persistent<Function> BulkQuery::constructor;
+
+void BulkQuery::Init() {
+    Nan::HandleScope scope;
+
+    // Prepare constructor template
+    Local<FunctionTemplate> tpl = Nan::New<FunctionTemplate>(New);
+    tpl->SetClassName(Nan::New("BulkQuery").ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+    Nan::SetPrototypeMethod(tpl, "execute", WRAPPED_METHOD_NAME(Execute));
+
+    constructor.Reset(tpl->GetFunction());
+}
+
+Local<Object> BulkQuery::NewInstance() {
+    Nan::EscapableHandleScope scope;
+
+    const unsigned argc = 0;
+    Local<Value> argv[argc] = {};
+    Local<Function> cons = Nan::New<Function>(constructor);
+//    Local<Object> instance = Nan::NewInstance(cons, argc, argv).ToLocalChecked();
+    Local<Object> instance = cons->NewInstance(argc, argv);
+
+    return scope.Escape(instance);
+}
+
+NAN_METHOD(BulkQuery::New) {
+    Nan::EscapableHandleScope scope;
+
+    BulkQuery* obj = new BulkQuery();
+    obj->Wrap(info.This());
+
+    info.GetReturnValue().Set(info.This());
+}
+
+BulkQuery::BulkQuery()
+{
+    session_ = NULL;
+    fetching_ = false;
+    prepared_ = NULL;
+    columnar_ = false;
+    count_ = 0;
+    concurrency_ = 0;
+    next_ = 0;
+    in_flight_ = 0;
+    callback_ = NULL;
+}
+
+BulkQuery::~BulkQuery()
+{
+    params_.Reset();
+    param_types_.Reset();
+    delete callback_;
+}
+
+void
+BulkQuery::set_client(v8::Local<v8::Object> client)
+{
+    static PersistentString client_str("client");
+    Nan::Set(this->handle(), client_str, client);
+
+    Client* c = Nan::ObjectWrap::Unwrap<Client>(client);
+    session_ = c->get_session();
+    async_ = c->get_async();
+    metrics_ = c->metrics();
+}
+
+WRAPPED_METHOD(BulkQuery, Execute)
+{
+    Nan::HandleScope scope;
+
+    if (info.Length() != 4) {
+        return Nan::ThrowError("execute requires 4 arguments: prepared, params, options, callback");
+    }
+
+    if (! PreparedQuery::HasInstance(info[0])) {
+        return Nan::ThrowError("execute requires a valid prepared object");
+    }
+
+    if (! info[1]->IsArray()) {
+        return Nan::ThrowError("execute requires params to be an array");
+    }
+
+    if (session_ == NULL) {
+        return Nan::ThrowError("client must be connected");
+    }
+
+    // Guard against running multiple times in parallel
+    if (fetching_) {
+        return Nan::ThrowError("execute already in progress");
+    }
+
+    Local<Object> prepared_obj = info[0].As<Object>();
+    PreparedQuery* prepared = Nan::ObjectWrap::Unwrap<PreparedQuery>(prepared_obj);
+    if (! prepared->is_prepared()) {
+        return Nan::ThrowError("execute can only be called after prepare");
+    }
+
+    Local<Array> params = info[1].As<Array>();
+    Local<Object> options = info[2].As<Object>();
+
+    static PersistentString param_types_str("param_types");
+    Local<Object> param_types;
+    if (Nan::Has(options, param_types_str).FromJust()) {
+        param_types = Nan::To<v8::Object>(Nan::Get(options, param_types_str).ToLocalChecked()).ToLocalChecked();
+    }
+
+    concurrency_ = 100;
+    static PersistentString concurrency_str("concurrency");
+    if (Nan::Has(options, concurrency_str).FromJust()) {
+        concurrency_ = Nan::Get(options, concurrency_str).ToLocalChecked()->Uint32Value();
+        if (concurrency_ == 0) {
+            return Nan::ThrowError("concurrency must be positive");
+        }
+    }
+
+    // With the columnar option params holds one array per parameter rather
+    // than one per row.
+    static PersistentString columnar_str("columnar");
+    bool columnar = false;
+    if (Nan::Has(options, columnar_str).FromJust()) {
+        columnar = Nan::To<bool>(Nan::Get(options, columnar_str).ToLocalChecked()).FromJust();
+    }
+    if (columnar) {
+        int64_t row_count = -1;
+        std::string error;
+        if (! ColumnBinder::row_count_option(options, &row_count, &error)) {
+            return Nan::ThrowError(error.c_str());
+        }
+
+        ColumnBinder columns;
+        if (! columns.init(prepared, params, row_count, &error)) {
+            return Nan::ThrowError(error.c_str());
+        }
+        count_ = columns.row_count();
+    } else {
+        count_ = params->Length();
+    }
+
+    fetching_ = true;
+
+    // Need a reference while the operation is in progress, and the prepared
+    // query and params have to stay alive until everything is bound
+    Ref();
+
+    static PersistentString prepared_str("prepared");
+    Nan::Set(this->handle(), prepared_str, prepared_obj);
+    prepared_ = prepared;
+    params_.Reset(params);
+    if (! param_types.IsEmpty()) {
+        param_types_.Reset(param_types);
+    }
+    columnar_ = columnar;
+
+    callback_ = new Nan::Callback(info[3].As<Function>());
+
+    submit();
+
+    // Nothing to wait for if no rows (or none that could be bound), but the
+    // callback still mustn't be called before execute returns
+    if (in_flight_ == 0) {
+        async_->defer(on_done, this, NULL);
+    }
+
+    return;
+}
+
+void
+BulkQuery::submit()
+{
+    if (in_flight_ >= concurrency_ || next_ >= count_) {
+        return;
+    }
+
+    Nan::HandleScope scope;
+
+    Local<Array> params = Nan::New(params_);
+    Local<Object> param_types;
+    if (! param_types_.IsEmpty()) {
+        param_types = Nan::New(param_types_);
+    }
+
+    // The column binder holds raw pointers into the typed arrays, so it is
+    // set up again for each call rather than kept between callbacks.
+    ColumnBinder columns;
+    if (columnar_) {
+        std::string error;
+        if (! columns.init(prepared_, params, count_, &error)) {
+            // The columns were changed while the statements were running
+            for (; next_ < count_; ++next_) {
+                errors_.push_back(RowError(next_, error));
+            }
+            return;
+        }
+    }
+
+    // A row that can't be bound is reported in the results rather than
+    // failing the whole operation.
+    while (in_flight_ < concurrency_ && next_ < count_) {
+        size_t index = next_++;
+        CassStatement* statement;
+        int bindingStatus;
+        if (columnar_) {
+            statement = prepared_->prepare_statement();
+            bindingStatus = columns.bind(statement, index);
+        } else {
+            Local<Value> row = Nan::Get(params, index).ToLocalChecked();
+            if (! row->IsArray()) {
+                errors_.push_back(RowError(index, "params must be an array"));
+                continue;
+            }
+
+            statement = prepared_->prepare_statement();
+            bindingStatus = prepared_->bind(statement, row.As<Array>(), param_types);
+        }
+
+        if (bindingStatus != -1) {
+            char err[1024];
+            sprintf(err, "error binding statement argument %d", bindingStatus);
+            errors_.push_back(RowError(index, err));
+            cass_statement_free(statement);
+            continue;
+        }
+
+        CassFuture* future = cass_session_execute(session_, statement);
+        cass_statement_free(statement);
+
+        in_flight_++;
+        metrics_->start_request();
+        async_->schedule(on_result_ready, future, this, (void*)(uintptr_t)index);
+    }
+}
+
+void
+BulkQuery::on_result_ready(CassFuture* future, void* client, void* data)
+{
+    BulkQuery* self = (BulkQuery*)client;
+    self->result_ready(future, (size_t)(uintptr_t)data);
+}
+
+void
+BulkQuery::on_done(CassFuture* future, void* client, void* data)
+{
+    BulkQuery* self = (BulkQuery*)client;
+    self->done();
+}
+
+void
+BulkQuery::result_ready(CassFuture* future, size_t index)
+{
+    Nan::HandleScope scope;
+
+    metrics_->stop_request();
+    in_flight_--;
+
+    if (cass_future_error_code(future) != CASS_OK) {
+        const char* msg;
+        size_t msg_len;
+        cass_future_error_message(future, &msg, &msg_len);
+        errors_.push_back(RowError(index, std::string(msg, msg_len)));
+    }
+    cass_future_free(future);
+
+    submit();
+
+    if (in_flight_ == 0) {
+        done();
+    }
+}
+
+void
+BulkQuery::done()
+{
+    Nan::HandleScope scope;
+
+    static PersistentString count_str("count");
+    static PersistentString failed_str("failed");
+    static PersistentString errors_str("errors");
+    static PersistentString index_str("index");
+    static PersistentString error_str("error");
+
+    Local<Array> errors = Nan::New<Array>(errors_.size());
+    for (size_t i = 0; i < errors_.size(); ++i) {
+        Local<Object> error = Nan::New<Object>();
+        Nan::Set(error, index_str, Nan::New<Number>(errors_[i].index_));
+        Nan::Set(error, error_str, Nan::Error(errors_[i].message_.c_str()));
+        Nan::Set(errors, i, error);
+    }
+
+    Local<Object> res = Nan::New<Object>();
+    Nan::Set(res, count_str, Nan::New<Number>(count_));
+    Nan::Set(res, failed_str, Nan::New<Number>(errors_.size()));
+    Nan::Set(res, errors_str, errors);
+
+    // Reset before calling back so the object can be reused from the
+    // callback.
+    Nan::Callback* callback = callback_;
+    callback_ = NULL;
+    prepared_ = NULL;
+    params_.Reset();
+    param_types_.Reset();
+    errors_.clear();
+    count_ = 0;
+    next_ = 0;
+    fetching_ = false;
+
+    Local<Value> argv[] = {
+        Nan::Null(),
+        res
+    };
+    AsyncFuture::call(callback, 2, argv);
+    delete callback;
+
+    Unref();
+}
@@ -0,0 +1,93 @@
+#ifndef __CASS_DRIVER_BULK_QUERY_H__
+#define __CASS_DRIVER_BULK_QUERY_H__
+
+#include "node.h"
+#include "nan.h"
+#include "wrapped-method.h"
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+class AsyncFuture;
+class Client;
+class Metrics;
+class PreparedQuery;
+
+// Wrapper to execute a prepared statement once for each of a list of
+// parameter sets.
+//
+// Statements are bound and submitted from native code as earlier ones
+// complete, keeping up to a given number of requests in flight, and the
+// callback is called once when all of them have completed. Only the
+// statements in flight are held in memory at a time.
+class BulkQuery: public Nan::ObjectWrap {
+public:
+    // Initialize the class constructor.
+    static void Init();
+
+    // Create a new instance of the class.
+    static v8::Local<v8::Object> NewInstance();
+
+    // Stash the reference to the parent client object and extract the pointer
+    // to the session.
+    void set_client(v8::Local<v8::Object> client);
+
+private:
+    BulkQuery();
+    ~BulkQuery();
+
+    // The actual implementation of the constructor
+    static NAN_METHOD(New);
+
+    // Execute the prepared query for all the parameter sets
+    WRAPPED_METHOD_DECL(Execute);
+
+    // Bind and submit statements until the concurrency limit is reached
+    void submit();
+
+    static void on_result_ready(CassFuture* future, void* client, void* data);
+    void result_ready(CassFuture* future, size_t index);
+
+    // Deferred call of done when there was nothing to wait for
+    static void on_done(CassFuture* future, void* client, void* data);
+
+    // Call back with the aggregate status and clean up
+    void done();
+
+    // Per statement error (binding or execution)
+    struct RowError {
+        RowError(size_t index, const std::string& message)
+            : index_(index), message_(message) {}
+
+        size_t index_;
+        std::string message_;
+    };
+
+    CassSession* session_;
+    AsyncFuture* async_;
+    Metrics* metrics_;
+
+    bool fetching_;
+
+    // The prepared query and the params (one array per row, or per
+    // parameter if columnar_) of the execution in progress
+    PreparedQuery* prepared_;
+    Nan::Persistent<Array> params_;
+    Nan::Persistent<Object> param_types_;
+    bool columnar_;
+
+    // Number of statements, index of the next one to bind and number of
+    // those submitted but not completed
+    size_t count_;
+    size_t concurrency_;
+    size_t next_;
+    size_t in_flight_;
+
+    std::vector<RowError> errors_;
+    Nan::Callback* callback_;
+
+    static Nan::Persistent<v8::Function> constructor;
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include <cassandra.h>
 
 #include "batch.h"
+#include "bulk-query.h"
 #include "client.h"
 #include "logging.h"
 #include "prepared-query.h"
@@ -19,6 +20,7 @@ void InitAll(Handle<Object> exports) {
     Nan::HandleScope scope;
 
     Batch::Init();
+    BulkQuery::Init();
     Client::Init();
     PreparedQuery::Init();
     Query::Init();
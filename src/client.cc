@@ -1,6 +1,7 @@
 
 #include "client.h"
 #include "batch.h"
+#include "bulk-query.h"
 #include "error-callback.h"
 #include "persistent-string.h"
 #include "prepared-query.h"
@@ -20,6 +21,7 @@ Client::Client()
 }
 
 Client::~Client() {
+    prepared_cache_.clear();
     cass_session_free(session_);
     cass_cluster_free(cluster_);
 }
@@ -36,8 +38,12 @@ void Client::Init() {
     Nan::SetPrototypeMethod(tpl, "connect", WRAPPED_METHOD_NAME(Connect));
     Nan::SetPrototypeMethod(tpl, "new_query", WRAPPED_METHOD_NAME(NewQuery));
     Nan::SetPrototypeMethod(tpl, "new_prepared_query", WRAPPED_METHOD_NAME(NewPreparedQuery));
+    Nan::SetPrototypeMethod(tpl, "prepare_cached", WRAPPED_METHOD_NAME(PrepareCached));
+    Nan::SetPrototypeMethod(tpl, "clear_prepared_cache", WRAPPED_METHOD_NAME(ClearPreparedCache));
     Nan::SetPrototypeMethod(tpl, "new_batch", WRAPPED_METHOD_NAME(NewBatch));
+    Nan::SetPrototypeMethod(tpl, "new_bulk_query", WRAPPED_METHOD_NAME(NewBulkQuery));
     Nan::SetPrototypeMethod(tpl, "metrics", WRAPPED_METHOD_NAME(GetMetrics));
+    Nan::SetPrototypeMethod(tpl, "set_dispatcher", WRAPPED_METHOD_NAME(SetDispatcher));
 
     constructor.Reset(tpl->GetFunction());
 
@@ -89,6 +95,7 @@ Client::configure(v8::Local<v8::Object> opts)
         cass_cluster_set_ ## _var(cluster_, value); \
     }
 
+        SET(protocol_version)
         SET(num_threads_io)
         SET(queue_size_io)
         SET(queue_size_event)
@@ -105,6 +112,7 @@ Client::configure(v8::Local<v8::Object> opts)
         SET(pending_requests_low_water_mark)
         SET(connect_timeout)
         SET(request_timeout)
+        SET(compression_threshold)
 
         if (strcmp(*key_str, "tcp_keepalive") == 0) {
             if (value == 0) {
@@ -115,6 +123,31 @@ Client::configure(v8::Local<v8::Object> opts)
             }
         }
 
+        if (strcmp(*key_str, "compression") == 0) {
+            const String::Utf8Value name(Nan::Get(opts, key).ToLocalChecked());
+            if (strcmp(*name, "lz4") == 0) {
+                cass_cluster_set_compression(cluster_, CASS_COMPRESSION_LZ4);
+            } else if (strcmp(*name, "none") != 0) {
+                return Nan::ThrowError("unsupported compression");
+            }
+        }
+
+        if (strcmp(*key_str, "prepared_cache_size") == 0) {
+            prepared_cache_.set_capacity(value);
+        }
+
+        if (strcmp(*key_str, "statement_metrics") == 0) {
+            metrics_.set_statement_metrics(value != 0);
+        }
+
+        if (strcmp(*key_str, "drain_count_budget") == 0) {
+            async_.set_drain_count_budget(value);
+        }
+
+        if (strcmp(*key_str, "drain_time_budget") == 0) {
+            async_.set_drain_time_budget(value);
+        }
+
         if (strcmp(*key_str, "tcp_nodelay") == 0) {
             if (value == 0) {
                 cass_cluster_set_tcp_nodelay(cluster_, cass_false);
@@ -122,6 +155,81 @@ Client::configure(v8::Local<v8::Object> opts)
                 cass_cluster_set_tcp_nodelay(cluster_, cass_true);
             }
         }
+
+        if (strcmp(*key_str, "token_aware_routing") == 0) {
+            cass_cluster_set_token_aware_routing(cluster_, value ? cass_true : cass_false);
+        }
+
+        if (strcmp(*key_str, "latency_aware_routing") == 0) {
+            cass_cluster_set_latency_aware_routing(cluster_, value ? cass_true : cass_false);
+        }
+    }
+
+    configure_load_balancing(opts);
+}
+
+// The load balancing policy takes several options at once, some of which
+// aren't integers, so they are handled separately from the rest.
+void
+Client::configure_load_balancing(v8::Local<v8::Object> opts)
+{
+    static PersistentString local_dc_str("local_dc");
+    static PersistentString used_hosts_str("used_hosts_per_remote_dc");
+    static PersistentString allow_remote_str("allow_remote_dcs_for_local_cl");
+
+    if (Nan::Has(opts, local_dc_str).FromJust()) {
+        String::Utf8Value local_dc(Nan::Get(opts, local_dc_str).ToLocalChecked());
+
+        unsigned used_hosts = 0;
+        if (Nan::Has(opts, used_hosts_str).FromJust()) {
+            used_hosts = Nan::Get(opts, used_hosts_str).ToLocalChecked()->Uint32Value();
+        }
+
+        bool allow_remote = false;
+        if (Nan::Has(opts, allow_remote_str).FromJust()) {
+            allow_remote = Nan::To<bool>(Nan::Get(opts, allow_remote_str).ToLocalChecked()).FromJust();
+        }
+
+        CassError rc = cass_cluster_set_load_balance_dc_aware_n(cluster_,
+            *local_dc, local_dc.length(), used_hosts,
+            allow_remote ? cass_true : cass_false);
+        if (rc != CASS_OK) {
+            return Nan::ThrowError("invalid local_dc");
+        }
+    }
+
+    // Unspecified latency aware settings keep the driver's defaults
+    static PersistentString exclusion_threshold_str("latency_exclusion_threshold");
+    static PersistentString scale_ms_str("latency_scale_ms");
+    static PersistentString retry_period_ms_str("latency_retry_period_ms");
+    static PersistentString update_rate_ms_str("latency_update_rate_ms");
+    static PersistentString min_measured_str("latency_min_measured");
+
+    double exclusion_threshold = 2.0;
+    uint64_t scale_ms = 100;
+    uint64_t retry_period_ms = 10000;
+    uint64_t update_rate_ms = 100;
+    uint64_t min_measured = 50;
+    bool latency_settings = false;
+
+#define GET_SETTING(_var, _type) \
+    if (Nan::Has(opts, _var ## _str).FromJust()) { \
+        _var = (_type) Nan::To<double>(Nan::Get(opts, _var ## _str).ToLocalChecked()).FromJust(); \
+        latency_settings = true; \
+    }
+
+    GET_SETTING(exclusion_threshold, double)
+    GET_SETTING(scale_ms, uint64_t)
+    GET_SETTING(retry_period_ms, uint64_t)
+    GET_SETTING(update_rate_ms, uint64_t)
+    GET_SETTING(min_measured, uint64_t)
+
+#undef GET_SETTING
+
+    if (latency_settings) {
+        cass_cluster_set_latency_aware_routing_settings(cluster_,
+            exclusion_threshold, scale_ms, retry_period_ms, update_rate_ms,
+            min_measured);
     }
 }
 
@@ -187,7 +295,7 @@ Client::connected(CassFuture* future, Nan::Callback* callback)
         Local<Value> argv[] = {
             Nan::Null(),
         };
-        callback->Call(1, argv);
+        AsyncFuture::call(callback, 1, argv);
     }
     cass_future_free(future);
     delete callback;
@@ -215,6 +323,34 @@ WRAPPED_METHOD(Client, NewPreparedQuery) {
     info.GetReturnValue().Set(val);
 }
 
+WRAPPED_METHOD(Client, PrepareCached) {
+    Nan::HandleScope scope;
+
+    if (info.Length() != 2) {
+        return Nan::ThrowError("prepare_cached requires 2 arguments: query, callback");
+    }
+
+    if (!info[0]->IsString()) {
+        return Nan::ThrowError("prepare_cached requires query to be a string");
+    }
+
+    if (!info[1]->IsFunction()) {
+        return Nan::ThrowError("prepare_cached requires callback to be a function");
+    }
+
+    Local<Object> prepared = prepared_cache_.get(this->handle(),
+                                                 info[0].As<String>(),
+                                                 info[1].As<Function>());
+    if (! prepared.IsEmpty()) {
+        info.GetReturnValue().Set(prepared);
+    }
+}
+
+WRAPPED_METHOD(Client, ClearPreparedCache) {
+    Nan::HandleScope scope;
+    prepared_cache_.clear();
+}
+
 WRAPPED_METHOD(Client, NewBatch) {
     Nan::HandleScope scope;
 
@@ -232,6 +368,16 @@ WRAPPED_METHOD(Client, NewBatch) {
     info.GetReturnValue().Set(val);
 }
 
+WRAPPED_METHOD(Client, NewBulkQuery) {
+    Nan::HandleScope scope;
+    Local<Value> val = BulkQuery::NewInstance();
+
+    BulkQuery* query = Nan::ObjectWrap::Unwrap<BulkQuery>(val->ToObject());
+    query->set_client(this->handle());
+
+    info.GetReturnValue().Set(val);
+}
+
 WRAPPED_METHOD(Client, GetMetrics) {
     Nan::HandleScope scope;
 
@@ -281,3 +427,19 @@ WRAPPED_METHOD(Client, GetMetrics) {
 #undef X
     info.GetReturnValue().Set(metrics);
 }
+
+WRAPPED_METHOD(Client, SetDispatcher) {
+    Nan::HandleScope scope;
+
+    if (info.Length() != 1) {
+        return Nan::ThrowError("set_dispatcher requires 1 argument: dispatcher");
+    }
+
+    if (info[0]->IsNull() || info[0]->IsUndefined()) {
+        async_.set_dispatcher(Local<Function>());
+    } else if (info[0]->IsFunction()) {
+        async_.set_dispatcher(info[0].As<Function>());
+    } else {
+        return Nan::ThrowError("set_dispatcher requires dispatcher to be a function");
+    }
+}
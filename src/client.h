@@ -7,6 +7,7 @@
 #include "wrapped-method.h"
 #include "async-future.h"
 #include "metrics.h"
+#include "prepared-cache.h"
 
 class Client : public Nan::ObjectWrap {
 public:
@@ -22,6 +23,7 @@ private:
 
     Metrics metrics_;
     AsyncFuture async_;
+    PreparedCache prepared_cache_;
 
     static void on_connected(CassFuture* future, void* client, void* data);
     void connected(CassFuture* future, Nan::Callback* callback);
@@ -34,10 +36,15 @@ private:
     WRAPPED_METHOD_DECL(Connect);
     WRAPPED_METHOD_DECL(NewQuery);
     WRAPPED_METHOD_DECL(NewPreparedQuery);
+    WRAPPED_METHOD_DECL(PrepareCached);
+    WRAPPED_METHOD_DECL(ClearPreparedCache);
     WRAPPED_METHOD_DECL(NewBatch);
+    WRAPPED_METHOD_DECL(NewBulkQuery);
     WRAPPED_METHOD_DECL(GetMetrics);
+    WRAPPED_METHOD_DECL(SetDispatcher);
 
     void configure(v8::Local<v8::Object> opts);
+    void configure_load_balancing(v8::Local<v8::Object> opts);
 
     static Nan::Persistent<v8::Function> constructor;
 };
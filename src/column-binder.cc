@@ -0,0 +1,226 @@
+#include <cassandra.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "column-binder.h"
+#include "persistent-string.h"
+#include "prepared-query.h"
+
+typedef bool (*encode_fn)(CassStatement* statement, u_int32_t i,
+                          const void* data, size_t row);
+
+template<typename T>
+static bool
+encode_int32(CassStatement* statement, u_int32_t i, const void* data, size_t row)
+{
+    cass_statement_bind_int32(statement, i, (cass_int32_t)((const T*)data)[row]);
+    return true;
+}
+
+template<typename T>
+static bool
+encode_int64(CassStatement* statement, u_int32_t i, const void* data, size_t row)
+{
+    cass_statement_bind_int64(statement, i, (cass_int64_t)((const T*)data)[row]);
+    return true;
+}
+
+// Doubles are only bound to a 64 bit column if they're integral and in
+// range, since anything else can't be converted without losing the value.
+template<>
+bool
+encode_int64<double>(CassStatement* statement, u_int32_t i, const void* data, size_t row)
+{
+    double value = ((const double*)data)[row];
+    // The range check also rejects NaN
+    if (!(value >= -9223372036854775808.0 && value < 9223372036854775808.0) ||
+        value != floor(value))
+    {
+        return false;
+    }
+    cass_statement_bind_int64(statement, i, (cass_int64_t)value);
+    return true;
+}
+
+template<typename T>
+static bool
+encode_float(CassStatement* statement, u_int32_t i, const void* data, size_t row)
+{
+    cass_statement_bind_float(statement, i, (cass_float_t)((const T*)data)[row]);
+    return true;
+}
+
+template<typename T>
+static bool
+encode_double(CassStatement* statement, u_int32_t i, const void* data, size_t row)
+{
+    cass_statement_bind_double(statement, i, (cass_double_t)((const T*)data)[row]);
+    return true;
+}
+
+// Pick the encoder for elements of type T as the given cassandra type and
+// extract the backing store of the array
+template<typename T>
+static encode_fn
+typed_encoder(Local<Value> array, CassValueType type, bool integral,
+              const void** data, size_t* length)
+{
+    Nan::TypedArrayContents<T> contents(array);
+    *data = *contents;
+    *length = contents.length();
+
+    switch (type) {
+    case CASS_VALUE_TYPE_INT:
+        return integral ? encode_int32<T> : (encode_fn)NULL;
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+        return encode_int64<T>;
+    case CASS_VALUE_TYPE_FLOAT:
+        return encode_float<T>;
+    case CASS_VALUE_TYPE_DOUBLE:
+        return encode_double<T>;
+    default:
+        return NULL;
+    }
+}
+
+ColumnBinder::ColumnBinder()
+{
+    row_count_ = 0;
+}
+
+ColumnBinder::encode_fn
+ColumnBinder::encoder(Local<Value> array, CassValueType type,
+                      const void** data, size_t* length)
+{
+    // Narrowing a 64 bit value to a 32 bit int column is never what was
+    // intended, so only Int32Array can be bound to an int.
+    encode_fn fn = NULL;
+    if (array->IsInt32Array()) {
+        fn = typed_encoder<int32_t>(array, type, true, data, length);
+    } else if (array->IsFloat64Array()) {
+        fn = typed_encoder<double>(array, type, false, data, length);
+    } else if (array->IsFloat32Array()) {
+        if (type == CASS_VALUE_TYPE_FLOAT || type == CASS_VALUE_TYPE_DOUBLE) {
+            fn = typed_encoder<float>(array, type, false, data, length);
+        }
+#ifdef HAVE_V8_BIGINT
+    } else if (array->IsBigInt64Array()) {
+        if (type == CASS_VALUE_TYPE_BIGINT || type == CASS_VALUE_TYPE_COUNTER ||
+            type == CASS_VALUE_TYPE_TIMESTAMP)
+        {
+            fn = typed_encoder<int64_t>(array, type, true, data, length);
+        }
+#endif
+    }
+    return fn;
+}
+
+bool
+ColumnBinder::init(PreparedQuery* prepared, Local<Array> columns, int64_t row_count,
+                   std::string* error)
+{
+    char err[1024];
+
+    size_t count = prepared->parameter_count();
+    if (columns->Length() != count) {
+        sprintf(err, "expected %u columns but got %u",
+                (unsigned)count, (unsigned)columns->Length());
+        *error = err;
+        return false;
+    }
+
+    columns_.resize(count);
+    size_t min_length = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Local<Value> array = Nan::Get(columns, i).ToLocalChecked();
+        CassValueType type = prepared->parameter_type(i);
+        Column& column = columns_[i];
+        size_t length;
+
+        column.encode_ = NULL;
+        column.data_ = NULL;
+        column.binder_ = NULL;
+
+        if (array->IsArray()) {
+            column.values_ = array.As<Array>();
+            if (prepared->parameter_binder(i).is_valid()) {
+                column.binder_ = &prepared->parameter_binder(i);
+            }
+            length = column.values_->Length();
+        } else if (array->IsTypedArray()) {
+            column.encode_ = encoder(array, type, &column.data_, &length);
+        }
+
+        if (column.encode_ == NULL && column.binder_ == NULL) {
+            sprintf(err, "column %u can't be bound to a parameter of type %d",
+                    (unsigned)i, (int)type);
+            *error = err;
+            return false;
+        }
+
+        if (i == 0 || length < min_length) {
+            min_length = length;
+        }
+    }
+
+    if (row_count < 0) {
+        row_count_ = min_length;
+    } else if ((size_t)row_count <= min_length) {
+        row_count_ = row_count;
+    } else {
+        sprintf(err, "columns are shorter than the row count %u", (unsigned)row_count);
+        *error = err;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+ColumnBinder::row_count_option(Local<Object> options, int64_t* row_count,
+                               std::string* error)
+{
+    static PersistentString row_count_str("rowCount");
+    if (! Nan::Has(options, row_count_str).FromJust()) {
+        return true;
+    }
+
+    Local<Value> value = Nan::Get(options, row_count_str).ToLocalChecked();
+    if (value->IsUndefined()) {
+        return true;
+    }
+
+    // The range check also rejects NaN
+    double count = value->IsNumber() ? Nan::To<double>(value).FromJust() : -1;
+    if (!(count >= 0 && count <= 9007199254740991.0) || count != floor(count)) {
+        *error = "rowCount must be a non-negative integer";
+        return false;
+    }
+    *row_count = (int64_t) count;
+    return true;
+}
+
+int
+ColumnBinder::bind(CassStatement* statement, size_t row)
+{
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        const Column& column = columns_[i];
+        if (column.encode_) {
+            if (! column.encode_(statement, i, column.data_, row)) {
+                return i;
+            }
+            continue;
+        }
+
+        Local<Value> value = Nan::Get(column.values_, row).ToLocalChecked();
+        if (value->IsNull()) {
+            cass_statement_bind_null(statement, i);
+        } else if (! column.binder_->bind(statement, i, value)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
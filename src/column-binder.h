@@ -0,0 +1,73 @@
+#ifndef __CASS_DRIVER_COLUMN_BINDER_H__
+#define __CASS_DRIVER_COLUMN_BINDER_H__
+
+#include "cassandra.h"
+#include "nan.h"
+#include "type-mapper.h"
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+class PreparedQuery;
+
+// Helper to bind rows of params to statements of a prepared query from data
+// held as one array per parameter.
+//
+// Typed arrays (Int32Array, Float32Array, Float64Array and, where supported,
+// BigInt64Array) are encoded straight from their backing store without
+// creating a Javascript value per cell. Plain arrays are bound one value at a
+// time like regular params.
+//
+// The binder holds raw pointers into the typed arrays and local handles, so
+// it must only be used within the scope of the call that initialized it.
+class ColumnBinder {
+public:
+    ColumnBinder();
+
+    // Set up the binder for the given prepared query and columns. The number
+    // of rows is row_count if given (non-negative) or the length of the
+    // columns otherwise. Returns false and sets error if a column doesn't
+    // match the prepared query.
+    bool init(PreparedQuery* prepared, Local<Array> columns, int64_t row_count,
+              std::string* error);
+
+    size_t row_count() const { return row_count_; }
+
+    // Read the rowCount option into row_count, which is left alone if the
+    // option isn't set. Returns false and sets error if it isn't a
+    // non-negative integer.
+    static bool row_count_option(Local<Object> options, int64_t* row_count,
+                                 std::string* error);
+
+    // Bind the given row to the statement. If one of the bindings fails,
+    // return the index of that column or -1 if successful.
+    int bind(CassStatement* statement, size_t row);
+
+private:
+    // Function to bind the row'th element of the backing store as the i'th
+    // parameter to a statement, returning false if the element doesn't fit
+    // the parameter's type
+    typedef bool (*encode_fn)(CassStatement* statement, u_int32_t i,
+                              const void* data, size_t row);
+
+    struct Column {
+        // Set for typed arrays
+        encode_fn encode_;
+        const void* data_;
+
+        // Set for plain arrays
+        const TypeMapper::ParamBinder* binder_;
+        Local<Array> values_;
+    };
+
+    // Return the function to encode elements of the given typed array as the
+    // given type, or NULL if they can't be
+    static encode_fn encoder(Local<Value> array, CassValueType type,
+                             const void** data, size_t* length);
+
+    std::vector<Column> columns_;
+    size_t row_count_;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include <cassandra.h>
+
+#include "decoded-page.h"
+
+DecodedPage::DecodedPage(const CassResult* result)
+{
+    result_ = result;
+    num_columns_ = cass_result_column_count(result);
+}
+
+bool
+DecodedPage::decode(const std::vector<u_int32_t>& codes)
+{
+    for (size_t i = 0; i < num_columns_; ++i) {
+        if (!TypeMapper::is_scalar(TypeMapper::cass_type_from_code(codes[i]))) {
+            return false;
+        }
+    }
+
+    values_.resize(cass_result_row_count(result_) * num_columns_);
+
+    CassIterator* iterator = cass_iterator_from_result(result_);
+    DecodedValue* value = values_.empty() ? NULL : &values_[0];
+    while (cass_iterator_next(iterator)) {
+        const CassRow* row = cass_iterator_get_row(iterator);
+        for (size_t i = 0; i < num_columns_; ++i, ++value) {
+            if (!TypeMapper::decode_value(value, codes[i], cass_row_get_column(row, i))) {
+                cass_iterator_free(iterator);
+                return false;
+            }
+        }
+    }
+    cass_iterator_free(iterator);
+
+    return true;
+}
@@ -0,0 +1,32 @@
+#ifndef __CASS_DRIVER_DECODED_PAGE_H__
+#define __CASS_DRIVER_DECODED_PAGE_H__
+
+#include "cassandra.h"
+#include "type-mapper.h"
+#include <vector>
+
+// The values of a page of results, extracted on the driver thread that
+// completed the request so that the main thread only needs to allocate the
+// Javascript values.
+//
+// Only pages whose columns are all scalar types can be decoded this way.
+class DecodedPage {
+public:
+    DecodedPage(const CassResult* result);
+
+    // Extract all of the values in the page using the given type code for
+    // each column. Returns false if the page can't be decoded, in which case
+    // the conversion is left to the main thread.
+    bool decode(const std::vector<u_int32_t>& codes);
+
+    const DecodedValue& get(size_t row, size_t column) const {
+        return values_[row * num_columns_ + column];
+    }
+
+private:
+    const CassResult* result_;
+    size_t num_columns_;
+    std::vector<DecodedValue> values_;
+};
+
+#endif
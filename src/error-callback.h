@@ -1,9 +1,11 @@
 #ifndef __CASS_DRIVER_ERROR_CALLBACK_H__
 #define __CASS_DRIVER_ERROR_CALLBACK_H__
 
+#include "async-future.h"
+
 /*
  * Call the given callback with a new error wrapping the msg extracted
- * from the given future.
+ * from the given future (or queue it for the dispatcher).
  */
 inline void error_callback(CassFuture* future, Nan::Callback* callback)
 {
@@ -19,7 +21,7 @@ inline void error_callback(CassFuture* future, Nan::Callback* callback)
         Nan::Error(err.c_str())
     };
 
-    callback->Call(1, argv);
+    AsyncFuture::call(callback, 1, argv);
 }
 
 #endif
@@ -0,0 +1,150 @@
+#include <cassandra.h>
+#include <stdint.h>
+
+#include "lazy-row.h"
+#include "decoded-page.h"
+#include "result.h"
+#include "shared-result.h"
+#include "string-table.h"
+
+Nan::Persistent<ObjectTemplate> LazyPage::tpl_;
+
+Local<Object>
+LazyPage::NewInstance(SharedResult* result, DecodedPage* decoded,
+                      const std::vector<u_int32_t>& codes, ColumnStrings* strings)
+{
+    Nan::EscapableHandleScope scope;
+
+    if (tpl_.IsEmpty()) {
+        Local<ObjectTemplate> tpl = Nan::New<ObjectTemplate>();
+        tpl->SetInternalFieldCount(1);
+        tpl_.Reset(tpl);
+    }
+
+    Local<Object> instance = Nan::NewInstance(Nan::New(tpl_)).ToLocalChecked();
+    LazyPage* obj = new LazyPage(result, decoded, codes, strings);
+    obj->Wrap(instance);
+
+    return scope.Escape(instance);
+}
+
+LazyPage::LazyPage(SharedResult* result, DecodedPage* decoded,
+                   const std::vector<u_int32_t>& codes, ColumnStrings* strings)
+    : codes_(codes)
+{
+    result_ = result;
+    result_->ref();
+    strings_ = strings;
+    strings_->ref();
+    decoded_ = decoded;
+    prepared_ = decoded != NULL;
+}
+
+LazyPage::~LazyPage()
+{
+    for (size_t n = 0; n < rows_.size(); ++n) {
+        cass_row_free(rows_[n]);
+    }
+    delete decoded_;
+    strings_->unref();
+    result_->unref();
+}
+
+void
+LazyPage::decode()
+{
+    prepared_ = true;
+
+    DecodedPage* decoded = new DecodedPage(result_->result());
+    if (decoded->decode(codes_)) {
+        decoded_ = decoded;
+        return;
+    }
+    delete decoded;
+
+    // Rows can't be reached by index otherwise
+    CassIterator* iterator = cass_iterator_from_result(result_->result());
+    while (cass_iterator_next(iterator)) {
+        rows_.push_back(cass_row_copy(cass_iterator_get_row(iterator)));
+    }
+    cass_iterator_free(iterator);
+}
+
+bool
+LazyPage::get(Local<Value>* value, size_t n, size_t i)
+{
+    if (! prepared_) {
+        decode();
+    }
+
+    if (decoded_) {
+        return Result::convert_decoded(value, codes_[i], i, decoded_->get(n, i),
+                                       strings_, result_);
+    }
+    return Result::convert_value(value, codes_[i], i, cass_row_get_column(rows_[n], i),
+                                 strings_, result_);
+}
+
+Local<ObjectTemplate>
+LazyRow::NewTemplate(const std::vector<Local<String> >& names)
+{
+    Nan::EscapableHandleScope scope;
+
+    Local<ObjectTemplate> tpl = Nan::New<ObjectTemplate>();
+    tpl->SetInternalFieldCount(FIELD_COUNT);
+
+    for (size_t i = 0; i < names.size(); ++i) {
+        // A column may be selected more than once but can only appear once
+        // in the template.
+        bool duplicate = false;
+        for (size_t j = 0; j < i && !duplicate; ++j) {
+            duplicate = names[i]->StrictEquals(names[j]);
+        }
+        if (duplicate) {
+            continue;
+        }
+
+        // The column index is passed to the accessor as an External
+        Local<Value> data = Nan::New<External>((void*)(uintptr_t)i);
+        Nan::SetAccessor(tpl, names[i], GetColumn, SetColumn, data);
+    }
+
+    return scope.Escape(tpl);
+}
+
+Local<Object>
+LazyRow::NewInstance(Local<ObjectTemplate> tpl, Local<Object> page, size_t n)
+{
+    Nan::EscapableHandleScope scope;
+
+    Local<Object> instance = Nan::NewInstance(tpl).ToLocalChecked();
+    instance->SetInternalField(PAGE_FIELD, page);
+    instance->SetInternalField(INDEX_FIELD, Nan::New<Uint32>((u_int32_t)n));
+
+    return scope.Escape(instance);
+}
+
+NAN_GETTER(LazyRow::GetColumn)
+{
+    Local<Object> holder = info.Holder();
+    LazyPage* page = Nan::ObjectWrap::Unwrap<LazyPage>(
+        holder->GetInternalField(PAGE_FIELD).As<Object>());
+    size_t n = holder->GetInternalField(INDEX_FIELD)->Uint32Value();
+    size_t i = (size_t)(uintptr_t)info.Data().As<External>()->Value();
+
+    Local<Value> result;
+    if (! page->get(&result, n, i)) {
+        return Nan::ThrowError("unable to obtain column value");
+    }
+
+    // Replace the accessor with the converted value so that subsequent reads
+    // are regular property loads.
+    Nan::DefineOwnProperty(holder, property, result);
+
+    info.GetReturnValue().Set(result);
+}
+
+NAN_SETTER(LazyRow::SetColumn)
+{
+    Nan::DefineOwnProperty(info.Holder(), property, value);
+}
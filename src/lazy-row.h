@@ -0,0 +1,77 @@
+#ifndef __CASS_DRIVER_LAZY_ROW_H__
+#define __CASS_DRIVER_LAZY_ROW_H__
+
+#include "cassandra.h"
+#include "nan.h"
+#include <vector>
+
+using namespace v8;
+
+class ColumnStrings;
+class DecodedPage;
+class SharedResult;
+
+// Handle on a page of results shared by all of its lazy rows.
+//
+// The page holds the only reference on the result, along with the type code
+// of each column and the values extracted from the page, which are decoded
+// (unless that was already done on the driver thread) the first time a
+// column of one of the rows is read.
+class LazyPage: public Nan::ObjectWrap {
+public:
+    // Create a new page handle, taking over the predecoded values (if any)
+    static Local<Object> NewInstance(SharedResult* result, DecodedPage* decoded,
+                                     const std::vector<u_int32_t>& codes,
+                                     ColumnStrings* strings);
+
+    // Convert the i'th column of the n'th row of the page
+    bool get(Local<Value>* value, size_t n, size_t i);
+
+private:
+    LazyPage(SharedResult* result, DecodedPage* decoded,
+             const std::vector<u_int32_t>& codes, ColumnStrings* strings);
+    ~LazyPage();
+
+    // Extract the values of the page, or copy out the rows if it has columns
+    // that can't be extracted ahead of conversion
+    void decode();
+
+    SharedResult* result_;
+    DecodedPage* decoded_;
+    std::vector<u_int32_t> codes_;
+    ColumnStrings* strings_;
+
+    bool prepared_;
+    std::vector<CassRow*> rows_;
+
+    static Nan::Persistent<ObjectTemplate> tpl_;
+};
+
+// Lightweight handle for a row of results whose column values are only
+// converted to Javascript the first time each property is read.
+//
+// A row is a plain object that holds its page and its index in the page in
+// internal fields, so there is no native state per row.
+class LazyRow {
+public:
+    // Build the template for rows with the given column names. Every column
+    // is exposed as an accessor that decodes the value and then replaces
+    // itself with a plain data property.
+    static Local<ObjectTemplate> NewTemplate(const std::vector<Local<String> >& names);
+
+    // Create a handle for the n'th row of the given page from the template.
+    static Local<Object> NewInstance(Local<ObjectTemplate> tpl, Local<Object> page,
+                                     size_t n);
+
+private:
+    enum {
+        PAGE_FIELD,
+        INDEX_FIELD,
+        FIELD_COUNT
+    };
+
+    static NAN_GETTER(GetColumn);
+    static NAN_SETTER(SetColumn);
+};
+
+#endif
@@ -3,10 +3,44 @@
 
 #include "nan.h"
 #include "persistent-string.h"
+#include "hdr_histogram.hpp"
+#include <map>
+#include <stdlib.h>
+#include <string>
+
+// Latency histograms for the executions of one statement, in microseconds.
+//
+// The wire latency is the time from submitting the request until the driver
+// completed it on its I/O thread, and the queue latency is the time from
+// there until the callback ran on the main thread. A high queue latency
+// means the event loop was too busy to pick up the results.
+struct StatementMetrics {
+    // Longest latency that is tracked, larger values are clamped to it
+    static const int64_t HIGHEST_LATENCY = 60LL * 1000 * 1000;
+
+    StatementMetrics()
+    {
+        hdr_init(1, HIGHEST_LATENCY, 3, &wire_);
+        hdr_init(1, HIGHEST_LATENCY, 3, &queue_);
+    }
+
+    ~StatementMetrics()
+    {
+        free(wire_);
+        free(queue_);
+    }
+
+    hdr_histogram* wire_;
+    hdr_histogram* queue_;
+};
 
 class Metrics {
 public:
-    Metrics() { clear(); }
+    // Maximum number of distinct statement tags to keep histograms for
+    static const size_t MAX_STATEMENTS = 1000;
+
+    Metrics() : statement_metrics_(false) { clear(); }
+    ~Metrics();
 
     // Reset (zero-out) the current metrics
     void clear();
@@ -20,13 +54,52 @@ public:
     // Decrement the counter(s) for a new request;
     void stop_request();
 
+    // Record a drain of the response queue that ran count callbacks in the
+    // given number of microseconds
+    void record_drain(uint32_t count, uint32_t elapsed);
+
+    // Whether prepared queries record statement histograms under their query
+    // text when they aren't given a tag
+    void set_statement_metrics(bool enabled) { statement_metrics_ = enabled; }
+    bool statement_metrics() const { return statement_metrics_; }
+
+    // Return the histograms for the given tag, or NULL if there are already
+    // MAX_STATEMENTS others. The histograms live as long as the Metrics.
+    StatementMetrics* statement(const std::string& tag);
+
+    // Record an execution that was submitted, completed by the driver,
+    // waited on by the application and handed to the main thread at the
+    // given uv_hrtime timestamps
+    void record_statement(StatementMetrics* statement, uint64_t start,
+                          uint64_t ready, uint64_t queued, uint64_t done);
+
     uint32_t request_count_;
     uint32_t response_count_;
     uint32_t pending_request_count_max_;
     uint32_t response_queue_drain_count_max_;
     uint32_t response_queue_drain_time_max_;
+
+    // Number of drains that stopped because the drain budget was spent
+    uint32_t response_queue_drain_deferred_count_;
+
+    // Bucket i counts the drains that took less than 2^i microseconds, and
+    // the last bucket counts all the longer ones.
+    enum { DRAIN_TIME_BUCKETS = 24 };
+    uint32_t response_queue_drain_time_histogram_[DRAIN_TIME_BUCKETS];
+
+    bool statement_metrics_;
+    typedef std::map<std::string, StatementMetrics*> StatementMap;
+    StatementMap statements_;
 };
 
+inline
+Metrics::~Metrics()
+{
+    for (StatementMap::iterator i = statements_.begin(); i != statements_.end(); ++i) {
+        delete i->second;
+    }
+}
+
 inline void
 Metrics::clear()
 {
@@ -35,6 +108,16 @@ Metrics::clear()
     pending_request_count_max_ = 0;
     response_queue_drain_count_max_ = 0;
     response_queue_drain_time_max_ = 0;
+    response_queue_drain_deferred_count_ = 0;
+    for (int i = 0; i < DRAIN_TIME_BUCKETS; ++i) {
+        response_queue_drain_time_histogram_[i] = 0;
+    }
+
+    // Queries hold on to the histograms, so only reset them
+    for (StatementMap::iterator i = statements_.begin(); i != statements_.end(); ++i) {
+        hdr_reset(i->second->wire_);
+        hdr_reset(i->second->queue_);
+    }
 }
 
 inline void
@@ -53,6 +136,84 @@ Metrics::stop_request()
     response_count_++;
 }
 
+inline void
+Metrics::record_drain(uint32_t count, uint32_t elapsed)
+{
+    if (count > response_queue_drain_count_max_) {
+        response_queue_drain_count_max_ = count;
+    }
+
+    if (elapsed > response_queue_drain_time_max_) {
+        response_queue_drain_time_max_ = elapsed;
+    }
+
+    int bucket = 0;
+    while (elapsed != 0 && bucket < DRAIN_TIME_BUCKETS - 1) {
+        elapsed >>= 1;
+        bucket++;
+    }
+    response_queue_drain_time_histogram_[bucket]++;
+}
+
+inline StatementMetrics*
+Metrics::statement(const std::string& tag)
+{
+    StatementMap::iterator i = statements_.find(tag);
+    if (i != statements_.end()) {
+        return i->second;
+    }
+    if (statements_.size() >= MAX_STATEMENTS) {
+        return NULL;
+    }
+    StatementMetrics* statement = new StatementMetrics();
+    statements_[tag] = statement;
+    return statement;
+}
+
+inline void
+record_latency(hdr_histogram* histogram, uint64_t from, uint64_t to)
+{
+    int64_t elapsed = to > from ? (int64_t)((to - from) / 1000) : 0;
+    if (elapsed > StatementMetrics::HIGHEST_LATENCY) {
+        elapsed = StatementMetrics::HIGHEST_LATENCY;
+    }
+    hdr_record_value(histogram, elapsed);
+}
+
+inline void
+Metrics::record_statement(StatementMetrics* statement, uint64_t start,
+                          uint64_t ready, uint64_t queued, uint64_t done)
+{
+    record_latency(statement->wire_, start, ready);
+    record_latency(statement->queue_, queued, done);
+}
+
+// Summary of a histogram, which must not be empty
+inline v8::Local<v8::Object>
+histogram_snapshot(hdr_histogram* h)
+{
+    v8::Local<v8::Object> snapshot = Nan::New<v8::Object>();
+
+#define GET(_name, _value) \
+    static PersistentString _name##str(#_name); \
+    Nan::Set(snapshot, _name##str, Nan::New<v8::Number>(_value));
+
+    GET(min, hdr_min(h));
+    GET(max, hdr_max(h));
+    GET(mean, hdr_mean(h));
+    GET(stddev, hdr_stddev(h));
+    GET(median, hdr_value_at_percentile(h, 50.0));
+    GET(p75, hdr_value_at_percentile(h, 75.0));
+    GET(p95, hdr_value_at_percentile(h, 95.0));
+    GET(p98, hdr_value_at_percentile(h, 98.0));
+    GET(p99, hdr_value_at_percentile(h, 99.0));
+    GET(p999, hdr_value_at_percentile(h, 99.9));
+
+#undef GET
+
+    return snapshot;
+}
+
 inline void
 Metrics::get(v8::Local<v8::Object> metrics)
 {
@@ -65,8 +226,41 @@ Metrics::get(v8::Local<v8::Object> metrics)
     GET(pending_request_count_max);
     GET(response_queue_drain_count_max);
     GET(response_queue_drain_time_max);
+    GET(response_queue_drain_deferred_count);
 
 #undef GET
+
+    static PersistentString histogram_str("response_queue_drain_time_histogram");
+    v8::Local<v8::Array> histogram = Nan::New<v8::Array>(DRAIN_TIME_BUCKETS);
+    for (int i = 0; i < DRAIN_TIME_BUCKETS; ++i) {
+        Nan::Set(histogram, i, Nan::New(response_queue_drain_time_histogram_[i]));
+    }
+    Nan::Set(metrics, histogram_str, histogram);
+
+    if (statements_.empty()) {
+        return;
+    }
+
+    static PersistentString statements_str("statements");
+    static PersistentString count_str("count");
+    static PersistentString wire_str("wire");
+    static PersistentString queue_str("queue");
+    v8::Local<v8::Object> statements = Nan::New<v8::Object>();
+    for (StatementMap::iterator i = statements_.begin(); i != statements_.end(); ++i) {
+        StatementMetrics* statement = i->second;
+        if (statement->wire_->total_count == 0) {
+            continue;
+        }
+
+        v8::Local<v8::Object> entry = Nan::New<v8::Object>();
+        Nan::Set(entry, count_str, Nan::New<v8::Number>(statement->wire_->total_count));
+        Nan::Set(entry, wire_str, histogram_snapshot(statement->wire_));
+        Nan::Set(entry, queue_str, histogram_snapshot(statement->queue_));
+        Nan::Set(statements,
+                 Nan::New<v8::String>(i->first.data(), i->first.size()).ToLocalChecked(),
+                 entry);
+    }
+    Nan::Set(metrics, statements_str, statements);
 }
 
 #endif
@@ -0,0 +1,155 @@
+#include <cassandra.h>
+
+#include "prepared-cache.h"
+#include "async-future.h"
+#include "error-callback.h"
+#include "prepared-query.h"
+
+PreparedCache::PreparedCache()
+{
+    capacity_ = 1000;
+}
+
+PreparedCache::~PreparedCache()
+{
+    for (EntryList::iterator i = lru_.begin(); i != lru_.end(); ++i) {
+        Entry* entry = *i;
+        for (size_t j = 0; j < entry->waiters_.size(); ++j) {
+            delete entry->waiters_[j];
+        }
+        delete entry;
+    }
+}
+
+void
+PreparedCache::set_capacity(size_t capacity)
+{
+    capacity_ = capacity;
+    evict();
+}
+
+void
+PreparedCache::clear()
+{
+    EntryList::iterator i = lru_.begin();
+    while (i != lru_.end()) {
+        Entry* entry = *i;
+        if (entry->statement_ == NULL) {
+            ++i;
+            continue;
+        }
+
+        index_.erase(entry->key_);
+        delete entry;
+        i = lru_.erase(i);
+    }
+}
+
+Local<Object>
+PreparedCache::get(Local<Object> client, Local<String> query,
+                   Local<Function> callback)
+{
+    Nan::EscapableHandleScope scope;
+
+    String::Utf8Value query_str(query);
+    std::string key(*query_str, query_str.length());
+
+    EntryIndex::iterator found = index_.find(key);
+    if (found != index_.end()) {
+        Entry* entry = *found->second;
+
+        // Move to the front of the list
+        lru_.splice(lru_.begin(), lru_, found->second);
+
+        if (entry->statement_) {
+            Local<Object> val = PreparedQuery::NewInstance();
+            PreparedQuery* prepared = Nan::ObjectWrap::Unwrap<PreparedQuery>(val);
+            prepared->set_client(client);
+            prepared->set_prepared(entry->statement_);
+            return scope.Escape(val);
+        }
+
+        entry->waiters_.push_back(new Nan::Callback(callback));
+        return Local<Object>();
+    }
+
+    Entry* entry = new Entry(key);
+    entry->waiters_.push_back(new Nan::Callback(callback));
+    lru_.push_front(entry);
+    index_[key] = lru_.begin();
+
+    Local<Object> val = PreparedQuery::NewInstance();
+    PreparedQuery* prepared = Nan::ObjectWrap::Unwrap<PreparedQuery>(val);
+    prepared->set_client(client);
+    prepared->set_cache(this, key);
+    prepared->prepare(*query_str, query_str.length(), NULL);
+
+    return Local<Object>();
+}
+
+void
+PreparedCache::prepared(const std::string& key, PreparedStatement* statement,
+                        Local<Object> prepared)
+{
+    EntryIndex::iterator found = index_.find(key);
+    if (found == index_.end()) {
+        return;
+    }
+
+    Entry* entry = *found->second;
+    statement->ref();
+    entry->statement_ = statement;
+
+    std::vector<Nan::Callback*> waiters;
+    waiters.swap(entry->waiters_);
+
+    evict();
+
+    for (size_t i = 0; i < waiters.size(); ++i) {
+        Local<Value> argv[] = {
+            Nan::Null(),
+            prepared
+        };
+        AsyncFuture::call(waiters[i], 2, argv);
+        delete waiters[i];
+    }
+}
+
+void
+PreparedCache::failed(const std::string& key, CassFuture* future)
+{
+    EntryIndex::iterator found = index_.find(key);
+    if (found == index_.end()) {
+        return;
+    }
+
+    // Forget about the query so the next caller tries again
+    Entry* entry = *found->second;
+    lru_.erase(found->second);
+    index_.erase(found);
+
+    for (size_t i = 0; i < entry->waiters_.size(); ++i) {
+        error_callback(future, entry->waiters_[i]);
+        delete entry->waiters_[i];
+    }
+    delete entry;
+}
+
+void
+PreparedCache::evict()
+{
+    size_t size = lru_.size();
+    EntryList::iterator i = lru_.end();
+    while (size > capacity_ && i != lru_.begin()) {
+        --i;
+        Entry* entry = *i;
+        if (entry->statement_ == NULL) {
+            continue;
+        }
+
+        index_.erase(entry->key_);
+        delete entry;
+        i = lru_.erase(i);
+        --size;
+    }
+}
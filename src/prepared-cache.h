@@ -0,0 +1,80 @@
+#ifndef __CASS_DRIVER_PREPARED_CACHE_H__
+#define __CASS_DRIVER_PREPARED_CACHE_H__
+
+#include "cassandra.h"
+#include "nan.h"
+#include "prepared-statement.h"
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+// Bounded LRU cache of prepared statements keyed by query string.
+//
+// A query that isn't cached yet is prepared once no matter how many callers
+// ask for it while the prepare is in flight, and all of them are called back
+// when it completes.
+//
+// Only the native statements are cached. Each hit gets a new PreparedQuery
+// object for them, since a cached object would keep the client (and so the
+// cache itself) from ever being collected.
+class PreparedCache {
+public:
+    PreparedCache();
+    ~PreparedCache();
+
+    // Set the maximum number of prepared queries to keep
+    void set_capacity(size_t capacity);
+
+    // Return a prepared query for the given client's cached statement.
+    //
+    // If it isn't cached, returns an empty handle and calls callback(err,
+    // prepared) once the query has been prepared (using the given client).
+    Local<Object> get(Local<Object> client, Local<String> query,
+                      Local<Function> callback);
+
+    // Drop all the cached statements. Queries that are still being prepared
+    // are kept so that their callers are called back.
+    void clear();
+
+    // Notification from the prepared query when the prepare completes
+    void prepared(const std::string& key, PreparedStatement* statement,
+                  Local<Object> prepared);
+    void failed(const std::string& key, CassFuture* future);
+
+private:
+    struct Entry {
+        Entry(const std::string& key) : key_(key), statement_(NULL) {}
+
+        ~Entry()
+        {
+            if (statement_) {
+                statement_->unref();
+            }
+        }
+
+        std::string key_;
+
+        // NULL until the prepare completes
+        PreparedStatement* statement_;
+
+        // Callbacks waiting for the prepare to complete
+        std::vector<Nan::Callback*> waiters_;
+    };
+
+    // Most recently used entries first
+    typedef std::list<Entry*> EntryList;
+    typedef std::map<std::string, EntryList::iterator> EntryIndex;
+
+    // Drop the least recently used prepared queries that exceed the capacity.
+    // Entries with a prepare in flight are kept.
+    void evict();
+
+    EntryList lru_;
+    EntryIndex index_;
+    size_t capacity_;
+};
+
+#endif
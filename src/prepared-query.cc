@@ -4,11 +4,13 @@
 #include "client.h"
 #include "error-callback.h"
 #include "persistent-string.h"
+#include "prepared-cache.h"
 #include "query.h"
 #include "metrics.h"
 #include "type-mapper.h"
 
 Nan::Persistent<Function> PreparedQuery::constructor;
+Nan::Persistent<FunctionTemplate> PreparedQuery::constructor_template;
 
 void PreparedQuery::Init() {
     Nan::HandleScope scope;
@@ -22,6 +24,12 @@ void PreparedQuery::Init() {
     Nan::SetPrototypeMethod(tpl, "query", WRAPPED_METHOD_NAME(GetQuery));
 
     constructor.Reset(tpl->GetFunction());
+    constructor_template.Reset(tpl);
+}
+
+bool PreparedQuery::HasInstance(Local<Value> value) {
+    Nan::HandleScope scope;
+    return Nan::New(constructor_template)->HasInstance(value);
 }
 
 Local<Object> PreparedQuery::NewInstance() {
@@ -49,6 +57,8 @@ PreparedQuery::PreparedQuery()
 {
     statement_ = NULL;
     prepared_ = NULL;
+    cache_ = NULL;
+    statement_metrics_ = NULL;
 }
 
 PreparedQuery::~PreparedQuery()
@@ -57,7 +67,7 @@ PreparedQuery::~PreparedQuery()
         cass_statement_free(statement_);
     }
     if (prepared_) {
-        cass_prepared_free(prepared_);
+        prepared_->unref();
     }
 }
 
@@ -73,6 +83,17 @@ PreparedQuery::set_client(v8::Local<v8::Object> client)
     metrics_ = c->metrics();
 }
 
+void
+PreparedQuery::set_prepared(PreparedStatement* prepared)
+{
+    prepared->ref();
+    if (prepared_) {
+        prepared_->unref();
+    }
+    prepared_ = prepared;
+    query_ = prepared->query();
+}
+
 WRAPPED_METHOD(PreparedQuery, Prepare)
 {
     Nan::HandleScope scope;
@@ -85,13 +106,21 @@ WRAPPED_METHOD(PreparedQuery, Prepare)
     Nan::Callback* callback = new Nan::Callback(info[1].As<Function>());
 
     String::Utf8Value query_str(query);
-    CassFuture* future = cass_session_prepare_n(session_, *query_str, query_str.length());
+    prepare(*query_str, query_str.length(), callback);
+
+    return;
+}
+
+void
+PreparedQuery::prepare(const char* query, size_t length, Nan::Callback* callback)
+{
+    query_.assign(query, length);
+
+    CassFuture* future = cass_session_prepare_n(session_, query, length);
     metrics_->start_request();
     async_->schedule(on_prepared_ready, future, this, callback);
 
     Ref();
-
-    return;
 }
 
 void
@@ -110,22 +139,45 @@ PreparedQuery::prepared_ready(CassFuture* future, Nan::Callback* callback)
     metrics_->stop_request();
     CassError code = cass_future_error_code(future);
     if (code != CASS_OK) {
-        error_callback(future, callback);
+        if (callback) {
+            error_callback(future, callback);
+        }
+        if (cache_) {
+            cache_->failed(cache_key_, future);
+        }
     } else {
-        prepared_ = cass_future_get_prepared(future);
-
-        Local<Value> argv[] = {
-            Nan::Null(),
-            this->handle()
-        };
-        callback->Call(2, argv);
+        PreparedStatement* prepared =
+            new PreparedStatement(query_, cass_future_get_prepared(future));
+        set_prepared(prepared);
+        prepared->unref();
+
+        if (callback) {
+            Local<Value> argv[] = {
+                Nan::Null(),
+                this->handle()
+            };
+            AsyncFuture::call(callback, 2, argv);
+        }
+        if (cache_) {
+            cache_->prepared(cache_key_, prepared_, this->handle());
+        }
     }
+    cache_ = NULL;
     cass_future_free(future);
     delete callback;
 
     Unref();
 }
 
+StatementMetrics*
+PreparedQuery::statement_metrics()
+{
+    if (statement_metrics_ == NULL && metrics_->statement_metrics()) {
+        statement_metrics_ = metrics_->statement(query_);
+    }
+    return statement_metrics_;
+}
+
 WRAPPED_METHOD(PreparedQuery, GetQuery)
 {
     Nan::HandleScope scope;
@@ -141,7 +193,7 @@ WRAPPED_METHOD(PreparedQuery, GetQuery)
     static PersistentString client_str("client");
     query->set_client(Nan::To<v8::Object>(Nan::Get(this->handle(), client_str).ToLocalChecked()).ToLocalChecked());
 
-    query->set_prepared_statement(prepare_statement());
+    query->set_prepared_statement(prepare_statement(), this);
 
     info.GetReturnValue().Set(val);
 }
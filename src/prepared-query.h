@@ -3,7 +3,11 @@
 
 #include "node.h"
 #include "nan.h"
+#include "prepared-statement.h"
+#include "result-schema.h"
+#include "type-mapper.h"
 #include "wrapped-method.h"
+#include <string>
 #include <vector>
 
 using namespace v8;
@@ -11,6 +15,8 @@ using namespace v8;
 class AsyncFuture;
 class Client;
 class Metrics;
+class PreparedCache;
+struct StatementMetrics;
 
 // Wrapper for an in-progress PreparedQuery to the back end
 class PreparedQuery: public Nan::ObjectWrap {
@@ -21,16 +27,74 @@ public:
     // Create a new instance of the class.
     static v8::Local<v8::Object> NewInstance();
 
+    // Check whether the given value wraps a PreparedQuery
+    static bool HasInstance(v8::Local<v8::Value> value);
+
     // Stash the reference to the parent client object and extract the pointer
     // to the session.
     void set_client(v8::Local<v8::Object> client);
 
+    // Report the outcome of the prepare to the given cache under the given
+    // key, in addition to the callback.
+    void set_cache(PreparedCache* cache, const std::string& key)
+    {
+        cache_ = cache;
+        cache_key_ = key;
+    }
+
+    // Send the prepare request, calling the callback (if any) on completion
+    void prepare(const char* query, size_t length, Nan::Callback* callback);
+
+    // Use a statement that has already been prepared
+    void set_prepared(PreparedStatement* prepared);
+
+    // Whether the prepare has completed successfully
+    bool is_prepared() const { return prepared_ != NULL; }
+
     // Return a new cassandra prepared statement
     CassStatement* prepare_statement()
     {
-        return cass_prepared_bind(prepared_);
+        return cass_prepared_bind(prepared_->prepared());
+    }
+
+    // Bind params to a statement returned by prepare_statement. Unless
+    // param_types are given, each value is encoded according to the type of
+    // its parameter in the prepared statement.
+    //
+    // If one of the bindings fails, return the index of that element or -1 if
+    // successful.
+    int bind(CassStatement* statement, Local<Array> params, Local<Object> param_types)
+    {
+        if (param_types.IsEmpty()) {
+            return TypeMapper::bind_statement_params(statement, params, prepared_->binders());
+        }
+        return TypeMapper::bind_statement_params(statement, params, param_types);
     }
 
+    // Description of the result columns, shared by all the queries created
+    // from this statement
+    ResultSchema* schema() { return prepared_->schema(); }
+
+    // Number and types of the parameters of the prepared statement
+    size_t parameter_count()
+    {
+        return cass_prepared_parameter_count(prepared_->prepared());
+    }
+
+    CassValueType parameter_type(size_t index)
+    {
+        return cass_prepared_parameter_type(prepared_->prepared(), index);
+    }
+
+    const TypeMapper::ParamBinder& parameter_binder(size_t index)
+    {
+        return prepared_->binders()[index];
+    }
+
+    // Histograms for executions that aren't given a tag, keyed by the query
+    // text, or NULL if statement metrics aren't enabled for the client
+    StatementMetrics* statement_metrics();
+
 private:
     PreparedQuery();
     ~PreparedQuery();
@@ -49,9 +113,16 @@ private:
     AsyncFuture* async_;
     Metrics* metrics_;
     CassStatement* statement_;
-    const CassPrepared* prepared_;
+    PreparedStatement* prepared_;
+
+    std::string query_;
+    StatementMetrics* statement_metrics_;
+
+    PreparedCache* cache_;
+    std::string cache_key_;
 
     static Nan::Persistent<v8::Function> constructor;
+    static Nan::Persistent<v8::FunctionTemplate> constructor_template;
 };
 
 #endif
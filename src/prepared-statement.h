@@ -0,0 +1,65 @@
+#ifndef __CASS_DRIVER_PREPARED_STATEMENT_H__
+#define __CASS_DRIVER_PREPARED_STATEMENT_H__
+
+#include "cassandra.h"
+#include "result-schema.h"
+#include "type-mapper.h"
+#include <string>
+#include <vector>
+
+// Reference counted result of a successful prepare: the driver's prepared
+// statement along with the parameter binders and result schema built from
+// its metadata.
+//
+// The prepared statement cache keeps a reference to it rather than to a
+// PreparedQuery object, so that caching a statement doesn't keep the client
+// that owns the cache reachable from Javascript.
+//
+// The count is not atomic since it is only used on the main v8 thread.
+class PreparedStatement {
+public:
+    PreparedStatement(const std::string& query, const CassPrepared* prepared)
+        : query_(query), prepared_(prepared), schema_(new ResultSchema()), refs_(1)
+    {
+        size_t count = cass_prepared_parameter_count(prepared_);
+        for (size_t i = 0; i < count; ++i) {
+            binders_.push_back(TypeMapper::param_binder(
+                cass_prepared_parameter_type(prepared_, i),
+                cass_prepared_parameter_primary_sub_type(prepared_, i),
+                cass_prepared_parameter_secondary_sub_type(prepared_, i)));
+        }
+    }
+
+    void ref() { ++refs_; }
+
+    void unref() {
+        if (--refs_ == 0) {
+            delete this;
+        }
+    }
+
+    const std::string& query() const { return query_; }
+    const CassPrepared* prepared() const { return prepared_; }
+
+    // Binder for each parameter, in order
+    const std::vector<TypeMapper::ParamBinder>& binders() const { return binders_; }
+
+    // Description of the result columns, shared by all the queries executed
+    // from this statement
+    ResultSchema* schema() { return schema_; }
+
+private:
+    ~PreparedStatement()
+    {
+        cass_prepared_free(prepared_);
+        schema_->unref();
+    }
+
+    std::string query_;
+    const CassPrepared* prepared_;
+    std::vector<TypeMapper::ParamBinder> binders_;
+    ResultSchema* schema_;
+    u_int32_t refs_;
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "query.h"
 #include "client.h"
 #include "metrics.h"
+#include "prepared-query.h"
 #include "type-mapper.h"
 #include "persistent-string.h"
 
@@ -61,6 +62,16 @@ Query::Query()
     fetching_ = false;
     statement_ = NULL;
     prepared_ = false;
+    prepared_query_ = NULL;
+    predecode_ = false;
+    prefetch_ = false;
+    prefetch_future_ = NULL;
+    prefetch_start_ = 0;
+    paging_size_ = 0;
+    prefetch_paging_size_ = 0;
+    statement_metrics_ = NULL;
+    start_time_ = 0;
+    execute_time_ = 0;
 }
 
 Query::~Query()
@@ -68,6 +79,10 @@ Query::~Query()
     --ACTIVE;
     dprintf("Query::~Query id %u active %u\n", id_, ACTIVE);
 
+    if (prefetch_future_) {
+        cass_future_free(prefetch_future_);
+    }
+
     if (statement_) {
         cass_statement_free(statement_);
     }
@@ -86,10 +101,16 @@ Query::set_client(v8::Local<v8::Object> client)
 }
 
 void
-Query::set_prepared_statement(CassStatement* statement)
+Query::set_prepared_statement(CassStatement* statement, PreparedQuery* prepared)
 {
+    // Keep the prepared query alive as long as this one might bind params
+    static PersistentString prepared_str("prepared");
+    Nan::Set(this->handle(), prepared_str, prepared->handle());
+
     statement_ = statement;
     prepared_ = true;
+    prepared_query_ = prepared;
+    result_.set_schema(prepared->schema());
 }
 
 WRAPPED_METHOD(Query, Parse)
@@ -114,10 +135,27 @@ WRAPPED_METHOD(Query, Parse)
         options = info[2].As<Object>();
     }
 
+    // The driver thread may still use the statement until the results are
+    // delivered
+    if (fetching_) {
+        return Nan::ThrowError("fetch already in progress");
+    }
+
+    // A prefetched page belongs to the previous statement, which the
+    // prefetch request keeps its own reference to
+    if (prefetch_future_) {
+        cass_future_free(prefetch_future_);
+        prefetch_future_ = NULL;
+    }
+
     // Stash the query so the client library can check it later.
     static PersistentString query_key("query");
     Nan::Set(this->handle(), query_key, query);
 
+    if (statement_) {
+        cass_statement_free(statement_);
+    }
+
     String::Utf8Value query_str(query);
     statement_ = cass_statement_new_n(*query_str, query_str.length(), num_params);
 
@@ -134,6 +172,20 @@ WRAPPED_METHOD(Query, Bind)
         return Nan::ThrowError("bind can only be called on a prepared query");
     }
 
+    if (fetching_) {
+        return Nan::ThrowError("fetch already in progress");
+    }
+
+    // A prefetched page is for the old params. Until its request has
+    // completed the statement can't be changed.
+    if (prefetch_future_) {
+        if (! cass_future_ready(prefetch_future_)) {
+            return Nan::ThrowError("bind while a prefetched page is pending");
+        }
+        cass_future_free(prefetch_future_);
+        prefetch_future_ = NULL;
+    }
+
     Local<Array> params = info[0].As<Array>();
     Local<Object> options = info[1].As<Object>();
 
@@ -149,7 +201,12 @@ Query::bind(Local<Array>& params, Local<Object>& options)
         param_types = Nan::To<v8::Object>(Nan::Get(options, param_types_str).ToLocalChecked()).ToLocalChecked();
     }
 
-    int bindingStatus = TypeMapper::bind_statement_params(statement_, params, param_types);
+    int bindingStatus;
+    if (prepared_query_) {
+        bindingStatus = prepared_query_->bind(statement_, params, param_types);
+    } else {
+        bindingStatus = TypeMapper::bind_statement_params(statement_, params, param_types);
+    }
 
     if (bindingStatus != -1) {
         char err[1024];
@@ -176,20 +233,62 @@ WRAPPED_METHOD(Query, Execute)
     if (fetching_) {
         return Nan::ThrowError("fetch already in progress");
     }
+
+    Local<Object> options = info[0].As<Object>();
+
+    static PersistentString row_mode_str("rowMode");
+    if (! options.IsEmpty() && Nan::Has(options, row_mode_str).FromJust()) {
+        String::Utf8Value row_mode(Nan::Get(options, row_mode_str).ToLocalChecked());
+        Result::RowMode mode;
+        if (! Result::parse_row_mode(*row_mode, &mode)) {
+            return Nan::ThrowError("invalid rowMode");
+        }
+        result_.set_row_mode(mode);
+    }
+
+    static PersistentString lazy_rows_str("lazyRows");
+    if (! options.IsEmpty() && Nan::Has(options, lazy_rows_str).FromJust() &&
+        Nan::To<bool>(Nan::Get(options, lazy_rows_str).ToLocalChecked()).FromJust())
+    {
+        if (result_.row_mode() != Result::ROW_MODE_OBJECT &&
+            result_.row_mode() != Result::ROW_MODE_LAZY)
+        {
+            return Nan::ThrowError("lazyRows requires rowMode object");
+        }
+        result_.set_row_mode(Result::ROW_MODE_LAZY);
+    }
+
+    static PersistentString predecode_str("predecode");
+    if (! options.IsEmpty() && Nan::Has(options, predecode_str).FromJust()) {
+        predecode_ = Nan::To<bool>(Nan::Get(options, predecode_str).ToLocalChecked()).FromJust();
+    }
+
+    static PersistentString prefetch_str("prefetch");
+    if (! options.IsEmpty() && Nan::Has(options, prefetch_str).FromJust()) {
+        prefetch_ = Nan::To<bool>(Nan::Get(options, prefetch_str).ToLocalChecked()).FromJust();
+    }
+
+    static PersistentString tag_str("tag");
+    statement_metrics_ = NULL;
+    if (! options.IsEmpty() && Nan::Has(options, tag_str).FromJust()) {
+        String::Utf8Value tag(Nan::Get(options, tag_str).ToLocalChecked());
+        statement_metrics_ = metrics_->statement(std::string(*tag, tag.length()));
+    } else if (prepared_query_) {
+        statement_metrics_ = prepared_query_->statement_metrics();
+    }
+
     fetching_ = true;
 
     // Need a reference while the operation is in progress
     Ref();
 
-    Local<Object> options = info[0].As<Object>();
     Nan::Callback* callback = new Nan::Callback(info[1].As<Function>());
 
-    u_int32_t paging_size = 5000;
+    paging_size_ = 5000;
     static PersistentString fetchSize("fetchSize");
     if (Nan::Has(options, fetchSize).FromJust()) {
-        paging_size = Nan::Get(options, fetchSize).ToLocalChecked()->Uint32Value();
+        paging_size_ = Nan::Get(options, fetchSize).ToLocalChecked()->Uint32Value();
     }
-    cass_statement_set_paging_size(statement_, paging_size);
 
     static PersistentString result_types_str("result_types");
     Local<Array> result_types;
@@ -202,18 +301,93 @@ WRAPPED_METHOD(Query, Execute)
         result_.set_column_types(types_array);
     }
 
-    // If there's a result from the previous iteration, update the paging state
-    // to fetch the next page and free it.
+    execute_time_ = uv_hrtime();
+    if (prefetch_future_ == NULL) {
+        execute_statement(callback);
+    } else if (prefetch_paging_size_ != paging_size_) {
+        // The prefetched page has the wrong size so it is dropped. The
+        // statement may only be modified once the prefetch request using it
+        // has completed, so the page is requested again from then.
+        CassFuture* future = prefetch_future_;
+        prefetch_future_ = NULL;
+        async_->schedule(on_prefetch_dropped, future, this, callback);
+    } else {
+        // The next page was already requested (and may well have arrived)
+        CassFuture* future = prefetch_future_;
+        prefetch_future_ = NULL;
+        start_time_ = prefetch_start_;
+        result_.release_result();
+        schedule(future, callback);
+    }
+
+    return;
+}
+
+void
+Query::execute_statement(Nan::Callback* callback)
+{
+    // If there's a result from the previous iteration, update the paging
+    // state to fetch the next page.
+    cass_statement_set_paging_size(statement_, paging_size_);
     if (result_.result()) {
         cass_statement_set_paging_state(statement_, result_.result());
-        cass_result_free(result_.result());
     }
-
+    start_time_ = uv_hrtime();
     CassFuture* future = cass_session_execute(session_, statement_);
+    result_.release_result();
+
+    schedule(future, callback);
+}
+
+void
+Query::schedule(CassFuture* future, Nan::Callback* callback)
+{
+    AsyncFuture::callback_t prepare = NULL;
+    if (predecode_ || prefetch_) {
+        prepare = on_result_prepare;
+    }
+
     metrics_->start_request();
-    async_->schedule(on_result_ready, future, this, callback);
+    async_->schedule(on_result_ready, future, this, callback, prepare);
+}
 
-    return;
+// Callback on the main v8 thread when a dropped prefetch request has
+// completed and the statement can be used for the page that was asked for
+void
+Query::on_prefetch_dropped(CassFuture* future, void* client, void* data)
+{
+    Query* self = (Query*)client;
+    Nan::Callback* callback = (Nan::Callback*) data;
+
+    cass_future_free(future);
+    self->execute_statement(callback);
+}
+
+// Callback on the driver thread when results are ready
+void
+Query::on_result_prepare(CassFuture* future, void* client, void* data)
+{
+    Query* self = (Query*)client;
+
+    const CassResult* result = self->result_.take_result(future);
+    if (result == NULL) {
+        return;
+    }
+
+    // Lazy rows only convert the predecoded values on demand
+    if (self->predecode_) {
+        self->result_.predecode();
+    }
+
+    // Request the next page right away so that it is (hopefully) ready by the
+    // time the application asks for it. The main thread doesn't touch the
+    // statement until this page has been delivered.
+    if (self->prefetch_ && cass_result_has_more_pages(result)) {
+        self->prefetch_paging_size_ = self->paging_size_;
+        cass_statement_set_paging_state(self->statement_, result);
+        self->prefetch_start_ = uv_hrtime();
+        self->prefetch_future_ = cass_session_execute(self->session_, self->statement_);
+    }
 }
 
 // Callback on the main v8 thread when results have been posted
@@ -231,6 +405,15 @@ Query::result_ready(CassFuture* future, Nan::Callback* callback)
     Nan::HandleScope scope;
 
     metrics_->stop_request();
+    if (statement_metrics_) {
+        // A prefetched page may have arrived long before it was claimed.
+        // Its wire time ends when the driver completed the request but it
+        // only queues for the main thread once execute asked for it.
+        uint64_t ready_time = cass_future_ready_time(future);
+        uint64_t queue_time = ready_time > execute_time_ ? ready_time : execute_time_;
+        metrics_->record_statement(statement_metrics_, start_time_, ready_time,
+                                   queue_time, uv_hrtime());
+    }
 
     fetching_ = false;
     result_.do_callback(future, callback);
@@ -12,6 +12,8 @@ using namespace v8;
 class AsyncFuture;
 class Client;
 class Metrics;
+class PreparedQuery;
+struct StatementMetrics;
 
 // Wrapper for an in-progress query to the back end
 class Query: public Nan::ObjectWrap {
@@ -26,8 +28,9 @@ public:
     // to the session.
     void set_client(v8::Local<v8::Object> client);
 
-    // Set a reference to a prepared statement
-    void set_prepared_statement(CassStatement* statement);
+    // Set a reference to a prepared statement and the prepared query it was
+    // created from
+    void set_prepared_statement(CassStatement* statement, PreparedQuery* prepared);
 
     // Get a pointer to the statement (to be used for batch queries)
     CassStatement* statement() { return statement_; }
@@ -52,15 +55,45 @@ private:
 
     Nan::NAN_METHOD_RETURN_TYPE bind(Local<Array>& params, Local<Object>& options);
 
+    // Request the next page with the statement and schedule the callback
+    void execute_statement(Nan::Callback* callback);
+    void schedule(CassFuture* future, Nan::Callback* callback);
+
+    static void on_prefetch_dropped(CassFuture* future, void* client, void* data);
+
     static void on_result_ready(CassFuture* future, void* client, void* data);
     void result_ready(CassFuture* future, Nan::Callback* callback);
 
+    // Called on the driver thread to predecode the results and prefetch the
+    // next page
+    static void on_result_prepare(CassFuture* future, void* client, void* data);
+
     CassSession* session_;
     CassStatement* statement_;
     Metrics* metrics_;
 
     bool prepared_;
+    PreparedQuery* prepared_query_;
     bool fetching_;
+    bool predecode_;
+    bool prefetch_;
+
+    // Speculative request for the next page, issued as soon as a page with
+    // more results arrives and claimed by the next call to execute.
+    CassFuture* prefetch_future_;
+    uint64_t prefetch_start_;
+
+    // Page size of the request in progress and of the prefetched one. A
+    // prefetched page is only used if the next execute asks for the same size.
+    u_int32_t paging_size_;
+    u_int32_t prefetch_paging_size_;
+
+    // Histograms to record the execution in (if any), along with the
+    // uv_hrtime at which the request was submitted and at which execute was
+    // called. These differ when execute claims a prefetched page.
+    StatementMetrics* statement_metrics_;
+    uint64_t start_time_;
+    uint64_t execute_time_;
 
     AsyncFuture* async_;
     Result result_;
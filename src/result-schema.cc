@@ -0,0 +1,82 @@
+#include <cassandra.h>
+
+#include "result-schema.h"
+#include "lazy-row.h"
+
+ResultSchema::~ResultSchema()
+{
+    clear();
+}
+
+void
+ResultSchema::clear()
+{
+    for (size_t i = 0; i < columns_.size(); ++i) {
+        columns_[i]->name_.Reset();
+        delete columns_[i];
+    }
+    columns_.clear();
+    row_template_.Reset();
+    lazy_template_.Reset();
+}
+
+void
+ResultSchema::init(const CassResult* result)
+{
+    size_t num_columns = cass_result_column_count(result);
+
+    // The columns of a prepared query only change if the schema of the table
+    // does, so checking the types is enough to catch that.
+    bool match = num_columns == columns_.size();
+    for (size_t i = 0; i < num_columns && match; ++i) {
+        match = cass_result_column_type(result, i) == columns_[i]->type_;
+    }
+    if (match) {
+        return;
+    }
+
+    clear();
+    for (size_t i = 0; i < num_columns; ++i) {
+        const char* name;
+        size_t name_length;
+        cass_result_column_name(result, i, &name, &name_length);
+        CassValueType type = cass_result_column_type(result, i);
+        columns_.push_back(new Column(name, name_length, type));
+    }
+}
+
+Local<ObjectTemplate>
+ResultSchema::row_template()
+{
+    if (row_template_.IsEmpty()) {
+        Local<ObjectTemplate> tpl = Nan::New<ObjectTemplate>();
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            Local<String> name = Nan::New(columns_[i]->name_);
+
+            // A column may be selected more than once but can only appear
+            // once in the template.
+            bool duplicate = false;
+            for (size_t j = 0; j < i && !duplicate; ++j) {
+                duplicate = name->StrictEquals(Nan::New(columns_[j]->name_));
+            }
+            if (!duplicate) {
+                Nan::SetTemplate(tpl, name, Nan::Null());
+            }
+        }
+        row_template_.Reset(tpl);
+    }
+    return Nan::New(row_template_);
+}
+
+Local<ObjectTemplate>
+ResultSchema::lazy_template()
+{
+    if (lazy_template_.IsEmpty()) {
+        std::vector<Local<String> > names;
+        for (size_t i = 0; i < columns_.size(); ++i) {
+            names.push_back(Nan::New(columns_[i]->name_));
+        }
+        lazy_template_.Reset(LazyRow::NewTemplate(names));
+    }
+    return Nan::New(lazy_template_);
+}
@@ -0,0 +1,65 @@
+#ifndef __CASS_DRIVER_RESULT_SCHEMA_H__
+#define __CASS_DRIVER_RESULT_SCHEMA_H__
+
+#include "cassandra.h"
+#include "nan.h"
+#include <vector>
+
+using namespace v8;
+
+// Reference counted description of the columns of a result: the column
+// names and types along with the templates used to create row objects.
+//
+// Each Result has one, but all the queries created from a prepared query
+// share the prepared query's schema so the names and templates are only
+// built for the first result.
+//
+// The count is not atomic since the schema is only used on the main v8
+// thread.
+class ResultSchema {
+public:
+    ResultSchema() : refs_(1) {}
+
+    void ref() { ++refs_; }
+
+    void unref() {
+        if (--refs_ == 0) {
+            delete this;
+        }
+    }
+
+    // Set up the columns from the given result, unless they already match.
+    void init(const CassResult* result);
+
+    size_t size() const { return columns_.size(); }
+    Local<String> name(size_t i) { return Nan::New(columns_[i]->name_); }
+    CassValueType type(size_t i) const { return columns_[i]->type_; }
+
+    // Template for object rows, with one property per distinct column name
+    Local<ObjectTemplate> row_template();
+
+    // Template for lazy rows, with one accessor per distinct column name
+    Local<ObjectTemplate> lazy_template();
+
+private:
+    ~ResultSchema();
+
+    void clear();
+
+    struct Column {
+        Column(const char* name, size_t name_length, CassValueType type) {
+            name_.Reset(Nan::New<v8::String>(name, name_length).ToLocalChecked());
+            type_ = type;
+        };
+
+        Nan::Persistent<v8::String> name_;
+        CassValueType type_;
+    };
+
+    std::vector<Column*> columns_;
+    Nan::Persistent<v8::ObjectTemplate> row_template_;
+    Nan::Persistent<v8::ObjectTemplate> lazy_template_;
+    u_int32_t refs_;
+};
+
+#endif
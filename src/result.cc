@@ -1,26 +1,104 @@
 #include <cassandra.h>
+#include <string.h>
 
 #include "result.h"
+#include "async-future.h"
 #include "error-callback.h"
+#include "lazy-row.h"
 #include "persistent-string.h"
 #include "type-mapper.h"
 
 Result::Result()
 {
     result_ = NULL;
+    row_mode_ = ROW_MODE_OBJECT;
+    taken_result_ = NULL;
+    decoded_ = NULL;
+    schema_ = new ResultSchema();
+    strings_ = new ColumnStrings();
 }
 
 Result::~Result()
+{
+    release_result();
+    schema_->unref();
+    strings_->unref();
+}
+
+void
+Result::set_schema(ResultSchema* schema)
+{
+    schema->ref();
+    schema_->unref();
+    schema_ = schema;
+}
+
+void
+Result::set_column_types(const std::vector<u_int32_t>& types)
+{
+    if (types != type_codes_) {
+        clear_string_tables();
+        type_codes_ = types;
+    }
+}
+
+void
+Result::clear_string_tables()
+{
+    strings_->unref();
+    strings_ = new ColumnStrings();
+}
+
+void
+Result::release_result()
 {
     if (result_) {
-        cass_result_free(result_);
+        result_->unref();
+        result_ = NULL;
     }
+}
 
-    for (size_t i = 0; i < column_info_.size(); ++i) {
-        column_info_[i]->name_.Reset();
-        delete column_info_[i];
+bool
+Result::parse_row_mode(const char* str, RowMode* mode)
+{
+    if (strcmp(str, "object") == 0) {
+        *mode = ROW_MODE_OBJECT;
+    } else if (strcmp(str, "array") == 0) {
+        *mode = ROW_MODE_ARRAY;
+    } else if (strcmp(str, "columnar") == 0) {
+        *mode = ROW_MODE_COLUMNAR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const CassResult*
+Result::take_result(CassFuture* future)
+{
+    if (cass_future_error_code(future) != CASS_OK) {
+        return NULL;
+    }
+
+    taken_result_ = cass_future_get_result(future);
+    return taken_result_;
+}
+
+void
+Result::predecode()
+{
+    size_t num_columns = cass_result_column_count(taken_result_);
+    std::vector<u_int32_t> codes;
+    for (size_t i = 0; i < num_columns; ++i) {
+        codes.push_back(column_type(i, cass_result_column_type(taken_result_, i)));
+    }
+
+    DecodedPage* decoded = new DecodedPage(taken_result_);
+    if (decoded->decode(codes)) {
+        decoded_ = decoded;
+    } else {
+        delete decoded;
     }
-    column_info_.empty();
 }
 
 void
@@ -34,70 +112,423 @@ Result::do_callback(CassFuture* future, Nan::Callback* callback)
         return;
     }
 
-    result_ = cass_future_get_result(future);
+    release_result();
+    if (taken_result_) {
+        result_ = new SharedResult(taken_result_);
+        taken_result_ = NULL;
+    } else {
+        result_ = new SharedResult(cass_future_get_result(future));
+    }
+    const CassResult* result = result_->result();
 
     Local<Object> res = Nan::New<Object>();
 
     static PersistentString more_str("more");
-    cass_bool_t more = cass_result_has_more_pages(result_);
+    cass_bool_t more = cass_result_has_more_pages(result);
     Nan::Set(res, more_str, more ? Nan::True() : Nan::False() );
 
+    // Stash the column info for the first batch of results (or the first
+    // query of a prepared statement).
+    size_t num_columns = cass_result_column_count(result);
+    schema_->init(result);
+
+    bool ok;
+    switch (row_mode_) {
+    case ROW_MODE_ARRAY:
+        ok = get_array_rows(res, num_columns);
+        break;
+    case ROW_MODE_COLUMNAR:
+        ok = get_columns(res, num_columns);
+        break;
+    case ROW_MODE_LAZY:
+        ok = get_lazy_rows(res, num_columns);
+        break;
+    case ROW_MODE_OBJECT:
+    default:
+        ok = get_object_rows(res, num_columns);
+        break;
+    }
+
+    delete decoded_;
+    decoded_ = NULL;
+
+    if (!ok) {
+        // XXX temporary until all the types are implemented in
+        // TypeMapper.
+        Local<Value> argv[] = {
+            Nan::Error("unable to obtain column value")
+        };
+        AsyncFuture::call(callback, 1, argv);
+        return;
+    }
+
+    Local<Value> argv[] = {
+        Nan::Null(),
+        res
+    };
+
+    AsyncFuture::call(callback, 2, argv);
+}
+
+CassIterator*
+Result::row_iterator()
+{
+    return decoded_ ? NULL : cass_iterator_from_result(result_->result());
+}
+
+// Advance the iterator returned by row_iterator to the next row
+static const CassRow*
+next_row(CassIterator* iterator)
+{
+    if (iterator == NULL || !cass_iterator_next(iterator)) {
+        return NULL;
+    }
+    return cass_iterator_get_row(iterator);
+}
+
+// Return true if values with the given type code go through a string table
+static bool
+is_interned(u_int32_t code)
+{
+    if (TypeMapper::encoding_from_code(code) != TypeMapper::STRING_INTERN) {
+        return false;
+    }
+    CassValueType type = TypeMapper::cass_type_from_code(code);
+    return type == CASS_VALUE_TYPE_ASCII || type == CASS_VALUE_TYPE_TEXT ||
+        type == CASS_VALUE_TYPE_VARCHAR;
+}
+
+bool
+Result::convert_decoded(Local<Value>* value, u_int32_t code, size_t i,
+                        const DecodedValue& decoded,
+                        ColumnStrings* strings, SharedResult* owner)
+{
+    if (!is_interned(code)) {
+        return TypeMapper::v8_from_decoded(value, code, decoded, owner);
+    }
+
+    if (decoded.is_null_) {
+        *value = Nan::Null();
+    } else {
+        *value = strings->get(i, TypeMapper::cass_type_from_code(code),
+                              decoded.data_, decoded.size_);
+    }
+    return true;
+}
+
+bool
+Result::convert_value(Local<Value>* value, u_int32_t code, size_t i,
+                      const CassValue* raw,
+                      ColumnStrings* strings, SharedResult* owner)
+{
+    if (!is_interned(code)) {
+        return TypeMapper::v8_from_cassandra(value, code, raw, owner);
+    }
+
+    DecodedValue decoded;
+    if (!TypeMapper::decode_value(&decoded, code, raw)) {
+        return false;
+    }
+    return convert_decoded(value, code, i, decoded, strings, owner);
+}
+
+bool
+Result::get_value(Local<Value>* value, size_t n, size_t i, const CassRow* row)
+{
+    u_int32_t code = column_type(i);
+    if (decoded_) {
+        return convert_decoded(value, code, i, decoded_->get(n, i), strings_, result_);
+    }
+    return convert_value(value, code, i, cass_row_get_column(row, i), strings_, result_);
+}
+
+bool
+Result::get_decoded(DecodedValue* value, size_t n, size_t i, const CassRow* row)
+{
+    if (decoded_) {
+        *value = decoded_->get(n, i);
+        return true;
+    }
+    return TypeMapper::decode_value(value, column_type(i), cass_row_get_column(row, i));
+}
+
+Local<Array>
+Result::column_names(size_t num_columns)
+{
+    Local<Array> names = Nan::New<Array>(num_columns);
+    for (size_t i = 0; i < num_columns; ++i) {
+        Nan::Set(names, i, schema_->name(i));
+    }
+    return names;
+}
+
+bool
+Result::get_object_rows(Local<Object> res, size_t num_columns)
+{
     static PersistentString rows_str("rows");
     Local<Array> data = Nan::New<Array>();
     Nan::Set(res, rows_str, data);
-    CassIterator* iterator = cass_iterator_from_result(result_);
-
-    // Stash the column info for the first batch of results.
-    size_t num_columns = cass_result_column_count(result_);
-    if (column_info_.size() == 0) {
-        for (size_t i = 0; i < num_columns; ++i) {
-            const char* name;
-            size_t name_length;
-            cass_result_column_name(result_, i, &name, &name_length);
-            CassValueType type = cass_result_column_type(result_, i);
-            column_info_.push_back(new Column(name, name_length, type));
+
+    Local<ObjectTemplate> tpl = schema_->row_template();
+    size_t num_rows = cass_result_row_count(result_->result());
+    CassIterator* iterator = row_iterator();
+
+    bool ok = true;
+    for (size_t n = 0; n < num_rows && ok; ++n) {
+        const CassRow* row = next_row(iterator);
+        Local<Object> element = Nan::NewInstance(tpl).ToLocalChecked();
+        for (size_t i = 0; i < num_columns && ok; ++i) {
+            Local<Value> result;
+            ok = get_value(&result, n, i, row);
+            if (ok) {
+                Nan::Set(element, schema_->name(i), result);
+            }
         }
+
+        Nan::Set(data, n, element);
     }
 
-    size_t n = 0;
-    while (cass_iterator_next(iterator)) {
-        const CassRow* row = cass_iterator_get_row(iterator);
-        Local<Object> element = Nan::New<Object>();
-        for (size_t i = 0; i < num_columns; ++i) {
+    if (iterator) {
+        cass_iterator_free(iterator);
+    }
+
+    return ok;
+}
+
+bool
+Result::get_array_rows(Local<Object> res, size_t num_columns)
+{
+    static PersistentString columns_str("columns");
+    Nan::Set(res, columns_str, column_names(num_columns));
+
+    static PersistentString rows_str("rows");
+    size_t num_rows = cass_result_row_count(result_->result());
+    Local<Array> data = Nan::New<Array>(num_rows);
+    Nan::Set(res, rows_str, data);
+
+    CassIterator* iterator = row_iterator();
+
+    bool ok = true;
+    for (size_t n = 0; n < num_rows && ok; ++n) {
+        const CassRow* row = next_row(iterator);
+        Local<Array> element = Nan::New<Array>(num_columns);
+        for (size_t i = 0; i < num_columns && ok; ++i) {
             Local<Value> result;
-            const CassValue* value = cass_row_get_column(row, i);
+            ok = get_value(&result, n, i, row);
+            if (ok) {
+                Nan::Set(element, i, result);
+            }
+        }
+
+        Nan::Set(data, n, element);
+    }
 
-            u_int32_t type;
-            if (i < type_codes_.size()) {
-                type = type_codes_[i];
-            } else {
-                type = column_info_[i]->type_;
+    if (iterator) {
+        cass_iterator_free(iterator);
+    }
+
+    return ok;
+}
+
+// Storage for one column of a columnar result. Numeric columns (and 64 bit
+// columns with the BIGINT_AS_BIGINT encoding) are packed into a typed array
+// until a null value is seen, at which point they fall back to a regular
+// array.
+struct ColumnValues {
+    Local<Object> values_;
+    CassValueType packed_type_; // CASS_VALUE_TYPE_UNKNOWN if not packed
+    void* data_;
+
+    ColumnValues(u_int32_t code, size_t num_rows)
+    {
+        packed_type_ = CASS_VALUE_TYPE_UNKNOWN;
+        data_ = NULL;
+
+#ifdef HAVE_V8_BIGINT
+        if (TypeMapper::encoding_from_code(code) == TypeMapper::BIGINT_AS_BIGINT) {
+            switch (TypeMapper::cass_type_from_code(code)) {
+            case CASS_VALUE_TYPE_BIGINT:
+            case CASS_VALUE_TYPE_COUNTER:
+            case CASS_VALUE_TYPE_TIMESTAMP: {
+                Isolate* isolate = Isolate::GetCurrent();
+                Local<ArrayBuffer> buf = ArrayBuffer::New(isolate, num_rows * sizeof(int64_t));
+                values_ = BigInt64Array::New(buf, 0, num_rows);
+                data_ = *Nan::TypedArrayContents<int64_t>(values_);
+                packed_type_ = CASS_VALUE_TYPE_BIGINT;
+                return;
+            }
+            default:
+                break;
+            }
+        }
+#endif
+
+        if (TypeMapper::encoding_from_code(code) == 0) {
+            Isolate* isolate = Isolate::GetCurrent();
+            switch (TypeMapper::cass_type_from_code(code)) {
+            case CASS_VALUE_TYPE_INT: {
+                Local<ArrayBuffer> buf = ArrayBuffer::New(isolate, num_rows * sizeof(int32_t));
+                values_ = Int32Array::New(buf, 0, num_rows);
+                data_ = *Nan::TypedArrayContents<int32_t>(values_);
+                packed_type_ = CASS_VALUE_TYPE_INT;
+                return;
             }
-            if (TypeMapper::v8_from_cassandra(&result, type, value))
-            {
-                Nan::Set(element, Nan::New(column_info_[i]->name_), result);
+            case CASS_VALUE_TYPE_DOUBLE: {
+                Local<ArrayBuffer> buf = ArrayBuffer::New(isolate, num_rows * sizeof(double));
+                values_ = Float64Array::New(buf, 0, num_rows);
+                data_ = *Nan::TypedArrayContents<double>(values_);
+                packed_type_ = CASS_VALUE_TYPE_DOUBLE;
+                return;
             }
-            else
-            {
-                // XXX temporary until all the types are implemented in
-                // TypeMapper.
-                Local<Value> argv[] = {
-                    Nan::Error("unable to obtain column value")
-                };
-                callback->Call(1, argv);
+            case CASS_VALUE_TYPE_FLOAT: {
+                Local<ArrayBuffer> buf = ArrayBuffer::New(isolate, num_rows * sizeof(float));
+                values_ = Float32Array::New(buf, 0, num_rows);
+                data_ = *Nan::TypedArrayContents<float>(values_);
+                packed_type_ = CASS_VALUE_TYPE_FLOAT;
                 return;
             }
+            default:
+                break;
+            }
         }
 
-        Nan::Set(data, n, element);
-        n++;
+        values_ = Nan::New<Array>(num_rows);
     }
-    cass_iterator_free(iterator);
 
-    Local<Value> argv[] = {
-        Nan::Null(),
-        res
-    };
+    // Store the value directly in the typed array, returning false if the
+    // value is null and the column needs to be unpacked.
+    bool set_packed(size_t n, const DecodedValue& value)
+    {
+        if (value.is_null_) {
+            return false;
+        }
+
+        switch (packed_type_) {
+        case CASS_VALUE_TYPE_INT:
+            ((cass_int32_t*)data_)[n] = value.int32_;
+            return true;
+        case CASS_VALUE_TYPE_DOUBLE:
+            ((cass_double_t*)data_)[n] = value.double_;
+            return true;
+        case CASS_VALUE_TYPE_FLOAT:
+            ((cass_float_t*)data_)[n] = value.float_;
+            return true;
+        case CASS_VALUE_TYPE_BIGINT:
+            ((cass_int64_t*)data_)[n] = value.int64_;
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Convert the first n packed values into a regular array.
+    void unpack(size_t n, size_t num_rows)
+    {
+        Local<Array> array = Nan::New<Array>(num_rows);
+#ifdef HAVE_V8_BIGINT
+        if (packed_type_ == CASS_VALUE_TYPE_BIGINT) {
+            Isolate* isolate = Isolate::GetCurrent();
+            for (size_t j = 0; j < n; ++j) {
+                Nan::Set(array, j, BigInt::New(isolate, ((cass_int64_t*)data_)[j]));
+            }
+            n = 0;
+        }
+#endif
+        for (size_t j = 0; j < n; ++j) {
+            double val;
+            switch (packed_type_) {
+            case CASS_VALUE_TYPE_INT:    val = ((cass_int32_t*)data_)[j]; break;
+            case CASS_VALUE_TYPE_DOUBLE: val = ((cass_double_t*)data_)[j]; break;
+            case CASS_VALUE_TYPE_FLOAT:  val = ((cass_float_t*)data_)[j]; break;
+            default: val = 0; break;
+            }
+            Nan::Set(array, j, Nan::New<Number>(val));
+        }
+        values_ = array;
+        packed_type_ = CASS_VALUE_TYPE_UNKNOWN;
+        data_ = NULL;
+    }
+};
+
+bool
+Result::get_columns(Local<Object> res, size_t num_columns)
+{
+    static PersistentString columns_str("columns");
+    Nan::Set(res, columns_str, column_names(num_columns));
+
+    size_t num_rows = cass_result_row_count(result_->result());
+
+    std::vector<ColumnValues> columns;
+    columns.reserve(num_columns);
+    for (size_t i = 0; i < num_columns; ++i) {
+        columns.push_back(ColumnValues(column_type(i), num_rows));
+    }
+
+    CassIterator* iterator = row_iterator();
+
+    bool ok = true;
+    for (size_t n = 0; n < num_rows && ok; ++n) {
+        const CassRow* row = next_row(iterator);
+        for (size_t i = 0; i < num_columns && ok; ++i) {
+            ColumnValues& column = columns[i];
+
+            if (column.packed_type_ != CASS_VALUE_TYPE_UNKNOWN) {
+                DecodedValue value;
+                ok = get_decoded(&value, n, i, row);
+                if (!ok || column.set_packed(n, value)) {
+                    continue;
+                }
+                column.unpack(n, num_rows);
+            }
+
+            Local<Value> result;
+            ok = get_value(&result, n, i, row);
+            if (ok) {
+                Nan::Set(column.values_, n, result);
+            }
+        }
+    }
+
+    if (iterator) {
+        cass_iterator_free(iterator);
+    }
+
+    if (!ok) {
+        return false;
+    }
+
+    static PersistentString values_str("values");
+    Local<Array> values = Nan::New<Array>(num_columns);
+    for (size_t i = 0; i < num_columns; ++i) {
+        Nan::Set(values, i, columns[i].values_);
+    }
+    Nan::Set(res, values_str, values);
+
+    return true;
+}
+
+bool
+Result::get_lazy_rows(Local<Object> res, size_t num_columns)
+{
+    static PersistentString rows_str("rows");
+    size_t num_rows = cass_result_row_count(result_->result());
+    Local<Array> data = Nan::New<Array>(num_rows);
+    Nan::Set(res, rows_str, data);
+
+    std::vector<u_int32_t> codes;
+    for (size_t i = 0; i < num_columns; ++i) {
+        codes.push_back(column_type(i));
+    }
+
+    // All the rows share one handle on the page, which takes over the
+    // predecoded values (if any)
+    Local<Object> page = LazyPage::NewInstance(result_, decoded_, codes, strings_);
+    decoded_ = NULL;
+
+    Local<ObjectTemplate> tpl = schema_->lazy_template();
+    for (size_t n = 0; n < num_rows; ++n) {
+        Nan::Set(data, n, LazyRow::NewInstance(tpl, page, n));
+    }
 
-    callback->Call(2, argv);
+    return true;
 }
@@ -3,6 +3,11 @@
 
 #include "cassandra.h"
 #include "nan.h"
+#include "decoded-page.h"
+#include "result-schema.h"
+#include "shared-result.h"
+#include "string-table.h"
+#include "type-mapper.h"
 #include <vector>
 
 using namespace v8;
@@ -13,30 +18,123 @@ public:
     Result();
     ~Result();
 
-    const CassResult* result() { return result_; }
+    // Layout of the rows handed back to Javascript
+    enum RowMode {
+        // One object per row keyed by column name (the default)
+        ROW_MODE_OBJECT,
+
+        // One array per row in column order, plus a column name header
+        ROW_MODE_ARRAY,
+
+        // One array (or typed array for numeric columns) per column, plus a
+        // column name header
+        ROW_MODE_COLUMNAR,
+
+        // One object per row keyed by column name, where each column value
+        // is only converted when it is first accessed
+        ROW_MODE_LAZY
+    };
+
+    const CassResult* result() { return result_ ? result_->result() : NULL; }
+
+    // Drop the reference to the current result. Values that still point into
+    // it keep it alive until they are collected.
+    void release_result();
 
     void do_callback(CassFuture* future, Nan::Callback* callback);
 
+    // Called on the driver thread when the future is ready to take the result
+    // before it is handed to the main thread. Returns NULL if the request
+    // failed.
+    const CassResult* take_result(CassFuture* future);
+
+    // Called on the driver thread after take_result to extract the values of
+    // the page.
+    void predecode();
+
     // Override the column types
-    void set_column_types(std::vector<u_int32_t> types) { type_codes_ = types; }
+    void set_column_types(const std::vector<u_int32_t>& types);
+
+    // Select the row layout
+    void set_row_mode(RowMode mode) { row_mode_ = mode; }
+    RowMode row_mode() const { return row_mode_; }
+
+    // Parse a row mode from the given string, returning false if unknown
+    static bool parse_row_mode(const char* str, RowMode* mode);
+
+    // Use the given (shared) schema for the column metadata instead of this
+    // result's own.
+    void set_schema(ResultSchema* schema);
+
+    // Convert a value of the i'th column with the given type code, either
+    // extracted by decode_value or straight from the row. Strings with the
+    // STRING_INTERN encoding go through the column's string table. Shared by
+    // all the row modes, including lazy rows.
+    static bool convert_decoded(Local<Value>* value, u_int32_t code, size_t i,
+                                const DecodedValue& decoded,
+                                ColumnStrings* strings, SharedResult* owner);
+    static bool convert_value(Local<Value>* value, u_int32_t code, size_t i,
+                              const CassValue* raw,
+                              ColumnStrings* strings, SharedResult* owner);
 
 private:
-    // Encapsulation of column metadata that can be cached for each row in the
-    // results.
-    struct Column {
-        Column(const char* name, size_t name_length, CassValueType type) {
-            name_.Reset(Nan::New<v8::String>(name, name_length).ToLocalChecked());
-            type_ = type;
-        };
-
-        Nan::Persistent<v8::String> name_;
-        CassValueType type_;
-    };
-    typedef std::vector<Column*> ColumnInfo;
 
-    ColumnInfo column_info_;
+    // Return the type code to use when converting the i'th column, given the
+    // column's own type. The type bits of an override may be left as
+    // CASS_VALUE_TYPE_UNKNOWN to only select an encoding for the column's own
+    // type.
+    u_int32_t column_type(size_t i, CassValueType type) {
+        if (i >= type_codes_.size()) {
+            return type;
+        }
+        u_int32_t code = type_codes_[i];
+        if (TypeMapper::cass_type_from_code(code) == CASS_VALUE_TYPE_UNKNOWN) {
+            return TypeMapper::encoding_from_code(code) | type;
+        }
+        return code;
+    }
+
+    u_int32_t column_type(size_t i) {
+        return column_type(i, schema_->type(i));
+    }
+
+    // Convert (or extract) the i'th column of the n'th row of the current
+    // page. The row is NULL if the page was predecoded.
+    bool get_value(Local<Value>* value, size_t n, size_t i, const CassRow* row);
+    bool get_decoded(DecodedValue* value, size_t n, size_t i, const CassRow* row);
+
+    // Start new string tables, e.g. when the column types change
+    void clear_string_tables();
+
+    // Return an iterator over the rows of the current page, or NULL if the
+    // page was predecoded and the driver's row decoding can be skipped.
+    CassIterator* row_iterator();
+
+    // Fill in the rows (or columns) of the result object according to the
+    // row mode, returning false if a value could not be converted.
+    bool get_object_rows(Local<Object> res, size_t num_columns);
+    bool get_array_rows(Local<Object> res, size_t num_columns);
+    bool get_columns(Local<Object> res, size_t num_columns);
+    bool get_lazy_rows(Local<Object> res, size_t num_columns);
+
+    // Return an array of the column names
+    Local<Array> column_names(size_t num_columns);
+
+    // Column names and types, along with the templates used to instantiate
+    // row objects so that every row is created with all of its properties in
+    // place and shares one map.
+    ResultSchema* schema_;
     std::vector<u_int32_t> type_codes_;
-    const CassResult* result_;
+
+    // Per column tables for the STRING_INTERN encoding, kept across pages
+    ColumnStrings* strings_;
+    RowMode row_mode_;
+    SharedResult* result_;
+
+    // Result taken on the driver thread and values extracted by predecode (if
+    // any) for the page that is about to be delivered.
+    const CassResult* taken_result_;
+    DecodedPage* decoded_;
 };
 
 #endif
@@ -0,0 +1,39 @@
+#ifndef __CASS_DRIVER_SHARED_RESULT_H__
+#define __CASS_DRIVER_SHARED_RESULT_H__
+
+#include "cassandra.h"
+
+// Reference counted holder for a CassResult.
+//
+// Values handed to Javascript may point directly into the response buffer
+// owned by the result (e.g. zero-copy blobs), so each of them holds a
+// reference that keeps the result alive after the query that produced it has
+// moved on to the next page or been collected.
+//
+// The count is not atomic since references are only taken and released on
+// the main v8 thread.
+class SharedResult {
+public:
+    explicit SharedResult(const CassResult* result)
+        : result_(result), refs_(1) {}
+
+    const CassResult* result() const { return result_; }
+
+    void ref() { ++refs_; }
+
+    void unref() {
+        if (--refs_ == 0) {
+            delete this;
+        }
+    }
+
+private:
+    ~SharedResult() {
+        cass_result_free(result_);
+    }
+
+    const CassResult* result_;
+    u_int32_t refs_;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include <string.h>
+
+#include "string-table.h"
+#include "type-mapper.h"
+
+StringTable::StringTable(CassValueType type)
+    : type_(type), slots_(MAX_ENTRIES * 2, NULL), count_(0)
+{
+}
+
+StringTable::~StringTable()
+{
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i]) {
+            slots_[i]->string_.Reset();
+            delete slots_[i];
+        }
+    }
+}
+
+// FNV-1a
+size_t
+StringTable::hash(const char* data, size_t size)
+{
+    size_t h = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        h = (h ^ (unsigned char)data[i]) * 16777619u;
+    }
+    return h;
+}
+
+Local<String>
+StringTable::get(const char* data, size_t size)
+{
+    size_t h = hash(data, size);
+    size_t mask = slots_.size() - 1;
+
+    size_t i = h & mask;
+    for (; slots_[i] != NULL; i = (i + 1) & mask) {
+        Entry* entry = slots_[i];
+        if (entry->hash_ == h && entry->bytes_.size() == size &&
+            memcmp(entry->bytes_.data(), data, size) == 0)
+        {
+            return Nan::New(entry->string_);
+        }
+    }
+
+    if (count_ >= MAX_ENTRIES) {
+        return TypeMapper::new_string(data, size, type_);
+    }
+
+    Local<String> str = TypeMapper::new_internalized_string(data, size, type_);
+    Entry* entry = new Entry();
+    entry->hash_ = h;
+    entry->bytes_.assign(data, size);
+    entry->string_.Reset(str);
+    slots_[i] = entry;
+    count_++;
+    return str;
+}
+
+ColumnStrings::~ColumnStrings()
+{
+    for (size_t i = 0; i < tables_.size(); ++i) {
+        delete tables_[i];
+    }
+}
+
+Local<String>
+ColumnStrings::get(size_t i, CassValueType type, const char* data, size_t size)
+{
+    if (i >= tables_.size()) {
+        tables_.resize(i + 1, NULL);
+    }
+    if (tables_[i] == NULL) {
+        tables_[i] = new StringTable(type);
+    }
+    return tables_[i]->get(data, size);
+}
@@ -0,0 +1,72 @@
+#ifndef __CASS_DRIVER_STRING_TABLE_H__
+#define __CASS_DRIVER_STRING_TABLE_H__
+
+#include "cassandra.h"
+#include "nan.h"
+#include <string>
+#include <vector>
+
+using namespace v8;
+
+// Table of the distinct values seen in a string column, so that a value
+// that repeats across rows is returned as the same internalized Javascript
+// string instead of creating a new one for every row.
+//
+// Meant for low cardinality columns. Once the table is full, values that
+// aren't in it yet are just created as regular strings.
+class StringTable {
+public:
+    // Maximum number of distinct values to keep
+    static const size_t MAX_ENTRIES = 1024;
+
+    StringTable(CassValueType type);
+    ~StringTable();
+
+    // Return the string with the given contents
+    Local<String> get(const char* data, size_t size);
+
+private:
+    struct Entry {
+        size_t hash_;
+        std::string bytes_;
+        Nan::Persistent<String> string_;
+    };
+
+    static size_t hash(const char* data, size_t size);
+
+    CassValueType type_;
+
+    // Open addressed with linear probing, with at least half the slots empty
+    std::vector<Entry*> slots_;
+    size_t count_;
+};
+
+// The string tables of the columns of a query's results, created as columns
+// are first seen.
+//
+// Lazy rows keep a reference so that they keep using the same tables as the
+// rest of the results after the query has moved on. Like SharedResult the
+// count is only touched on the main v8 thread.
+class ColumnStrings {
+public:
+    ColumnStrings() : refs_(1) {}
+
+    void ref() { ++refs_; }
+
+    void unref() {
+        if (--refs_ == 0) {
+            delete this;
+        }
+    }
+
+    // Return the string with the given contents from the i'th column's table
+    Local<String> get(size_t i, CassValueType type, const char* data, size_t size);
+
+private:
+    ~ColumnStrings();
+
+    std::vector<StringTable*> tables_;
+    u_int32_t refs_;
+};
+
+#endif
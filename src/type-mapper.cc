@@ -1,279 +1,1351 @@
 
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <uv.h>
+
 #include "type-mapper.h"
+#include "persistent-string.h"
+#include "shared-result.h"
 using namespace v8;
 
-static const u_int32_t BIGINT_AS_OBJECT = 0x1 << 16;
+static const u_int32_t BIGINT_AS_OBJECT = 0x1 << 16;
+static const u_int32_t BLOB_ZERO_COPY = 0x2 << 16;
+
+// Blobs smaller than this are copied even when BLOB_ZERO_COPY is requested
+// since the copy is cheaper than tracking the external buffer.
+static const size_t ZERO_COPY_MIN_SIZE = 1024;
+
+// Free callback for zero-copy buffers
+static void
+release_shared_result(char* data, void* hint)
+{
+    ((SharedResult*)hint)->unref();
+}
+
+// Lookup tables for formatting and parsing hex digits, filled in at load
+// time.
+static const char hex_chars[] = "0123456789abcdef";
+static signed char hex_values[256];
+
+static struct HexTablesInit {
+    HexTablesInit() {
+        memset(hex_values, -1, sizeof(hex_values));
+        for (int i = 0; i < 16; ++i) {
+            hex_values[(unsigned char)hex_chars[i]] = i;
+        }
+        for (int i = 10; i < 16; ++i) {
+            hex_values['A' + i - 10] = i;
+        }
+    }
+} hex_tables_init;
+
+// Write the low digits nibbles of v as hex
+static inline void
+write_hex(char* out, cass_uint64_t v, int digits)
+{
+    for (int i = digits - 1; i >= 0; --i) {
+        out[i] = hex_chars[v & 0xf];
+        v >>= 4;
+    }
+}
+
+// Parse digits hex characters into v, returning false if any of them isn't a
+// hex digit
+static inline bool
+read_hex(const char* in, int digits, cass_uint64_t* v)
+{
+    cass_uint64_t result = 0;
+    int invalid = 0;
+    for (int i = 0; i < digits; ++i) {
+        int nibble = hex_values[(unsigned char)in[i]];
+        invalid |= nibble;
+        result = (result << 4) | (nibble & 0xf);
+    }
+    *v = result;
+    return invalid >= 0;
+}
+
+// Format the uuid in the canonical 8-4-4-4-12 form (the same layout as
+// cass_uuid_string) into out, which must hold CASS_UUID_STRING_LENGTH - 1
+// characters.
+static void
+uuid_to_string(const CassUuid& uuid, char* out)
+{
+    write_hex(out, uuid.time_and_version & 0xffffffff, 8);
+    out[8] = '-';
+    write_hex(out + 9, (uuid.time_and_version >> 32) & 0xffff, 4);
+    out[13] = '-';
+    write_hex(out + 14, uuid.time_and_version >> 48, 4);
+    out[18] = '-';
+    write_hex(out + 19, uuid.clock_seq_and_node >> 48, 4);
+    out[23] = '-';
+    write_hex(out + 24, uuid.clock_seq_and_node & 0xffffffffffffULL, 12);
+}
+
+static bool
+uuid_from_string(const char* str, size_t length, CassUuid* uuid)
+{
+    if (length != CASS_UUID_STRING_LENGTH - 1 ||
+        str[8] != '-' || str[13] != '-' || str[18] != '-' || str[23] != '-')
+    {
+        return false;
+    }
+
+    cass_uint64_t time_low, time_mid, time_hi, clock_seq, node;
+    if (!read_hex(str, 8, &time_low) ||
+        !read_hex(str + 9, 4, &time_mid) ||
+        !read_hex(str + 14, 4, &time_hi) ||
+        !read_hex(str + 19, 4, &clock_seq) ||
+        !read_hex(str + 24, 12, &node))
+    {
+        return false;
+    }
+
+    uuid->time_and_version = time_low | (time_mid << 32) | (time_hi << 48);
+    uuid->clock_seq_and_node = (clock_seq << 48) | node;
+    return true;
+}
+
+// Format the address into out, which must hold CASS_INET_STRING_LENGTH
+// characters, returning the length.
+static size_t
+inet_to_string(const CassInet& inet, char* out)
+{
+    if (inet.address_length == CASS_INET_V4_LENGTH) {
+        // Dotted quad is by far the most common so avoid the generic path
+        char* pos = out;
+        for (int i = 0; i < CASS_INET_V4_LENGTH; ++i) {
+            unsigned int octet = inet.address[i];
+            if (i != 0) {
+                *pos++ = '.';
+            }
+            if (octet >= 100) {
+                *pos++ = '0' + octet / 100;
+            }
+            if (octet >= 10) {
+                *pos++ = '0' + (octet / 10) % 10;
+            }
+            *pos++ = '0' + octet % 10;
+        }
+        *pos = '\0';
+        return pos - out;
+    }
+
+    if (uv_inet_ntop(AF_INET6, inet.address, out, CASS_INET_STRING_LENGTH) != 0) {
+        return 0;
+    }
+    return strlen(out);
+}
+
+static bool
+inet_from_string(const char* str, CassInet* inet)
+{
+    cass_uint8_t address[CASS_INET_V6_LENGTH];
+    if (uv_inet_pton(AF_INET, str, address) == 0) {
+        *inet = cass_inet_init_v4(address);
+        return true;
+    }
+    if (uv_inet_pton(AF_INET6, str, address) == 0) {
+        *inet = cass_inet_init_v6(address);
+        return true;
+    }
+    return false;
+}
+
+// Format a varint (big-endian two's complement) as a decimal string
+static void
+varint_to_string(const cass_byte_t* data, size_t size, std::string* out)
+{
+    out->clear();
+    if (size == 0) {
+        out->assign("0");
+        return;
+    }
+
+    bool negative = (data[0] & 0x80) != 0;
+
+    // Anything that fits in 64 bits is formatted directly
+    if (size <= 8) {
+        cass_int64_t v = negative ? -1 : 0;
+        for (size_t i = 0; i < size; ++i) {
+            v = (cass_int64_t)(((cass_uint64_t)v << 8) | data[i]);
+        }
+        char buf[32];
+        size_t len = sprintf(buf, "%lld", (long long)v);
+        out->assign(buf, len);
+        return;
+    }
+
+    // Otherwise convert the magnitude to base 10^9 limbs (least significant
+    // first) and print those
+    std::vector<cass_uint32_t> limbs;
+    int carry = negative ? 1 : 0;
+    std::vector<cass_byte_t> magnitude(size);
+    for (size_t i = size; i-- > 0;) {
+        int byte = negative ? (~data[i] & 0xff) + carry : data[i];
+        carry = byte >> 8;
+        magnitude[i] = byte & 0xff;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        cass_uint64_t c = magnitude[i];
+        for (size_t j = 0; j < limbs.size(); ++j) {
+            c += (cass_uint64_t)limbs[j] << 8;
+            limbs[j] = c % 1000000000;
+            c /= 1000000000;
+        }
+        while (c != 0) {
+            limbs.push_back(c % 1000000000);
+            c /= 1000000000;
+        }
+    }
+
+    if (negative) {
+        out->append(1, '-');
+    }
+    if (limbs.empty()) {
+        out->append(1, '0');
+        return;
+    }
+
+    char buf[16];
+    out->append(buf, sprintf(buf, "%u", limbs.back()));
+    for (size_t i = limbs.size() - 1; i-- > 0;) {
+        out->append(buf, sprintf(buf, "%09u", limbs[i]));
+    }
+}
+
+// Format a decimal as a string with the scale applied
+static void
+decimal_to_string(const cass_byte_t* varint, size_t size, cass_int32_t scale,
+                  std::string* out)
+{
+    varint_to_string(varint, size, out);
+    if (scale < 0) {
+        if (*out != "0") {
+            out->append(-scale, '0');
+        }
+        return;
+    }
+    if (scale == 0) {
+        return;
+    }
+
+    size_t start = (*out)[0] == '-' ? 1 : 0;
+    size_t digits = out->size() - start;
+    if (digits <= (size_t)scale) {
+        out->insert(start, scale - digits + 1, '0');
+        digits = scale + 1;
+    }
+    out->insert(start + digits - scale, 1, '.');
+}
+
+// Parse a decimal number (with an optional fraction and exponent) into its
+// digits and scale
+static bool
+parse_decimal(const char* str, size_t length, bool* negative, std::string* digits,
+              cass_int32_t* scale)
+{
+    const char* pos = str;
+    const char* end = str + length;
+
+    *negative = false;
+    *scale = 0;
+    digits->clear();
+
+    if (pos != end && (*pos == '-' || *pos == '+')) {
+        *negative = *pos == '-';
+        ++pos;
+    }
+
+    bool point = false;
+    bool any = false;
+    for (; pos != end; ++pos) {
+        if (*pos >= '0' && *pos <= '9') {
+            any = true;
+            if (!digits->empty() || *pos != '0') {
+                digits->append(1, *pos);
+            }
+            if (point) {
+                ++*scale;
+            }
+        } else if (*pos == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    if (!any) {
+        return false;
+    }
+
+    if (pos != end && (*pos == 'e' || *pos == 'E')) {
+        char* exp_end;
+        long exponent = strtol(pos + 1, &exp_end, 10);
+        if (exp_end == pos + 1) {
+            return false;
+        }
+        *scale -= exponent;
+        pos = exp_end;
+    }
+
+    return pos == end;
+}
+
+// Encode decimal digits as a varint (big-endian two's complement)
+static void
+digits_to_varint(const std::string& digits, bool negative,
+                 std::vector<cass_byte_t>* out)
+{
+    // Build the magnitude least significant byte first
+    std::vector<cass_byte_t> magnitude;
+    for (size_t i = 0; i < digits.size(); ++i) {
+        unsigned int c = digits[i] - '0';
+        for (size_t j = 0; j < magnitude.size(); ++j) {
+            c += magnitude[j] * 10;
+            magnitude[j] = c & 0xff;
+            c >>= 8;
+        }
+        while (c != 0) {
+            magnitude.push_back(c & 0xff);
+            c >>= 8;
+        }
+    }
+
+    if (magnitude.empty()) {
+        out->assign(1, 0);
+        return;
+    }
+
+    if (negative) {
+        int carry = 1;
+        for (size_t j = 0; j < magnitude.size(); ++j) {
+            int byte = (~magnitude[j] & 0xff) + carry;
+            carry = byte >> 8;
+            magnitude[j] = byte & 0xff;
+        }
+        if ((magnitude.back() & 0x80) == 0) {
+            magnitude.push_back(0xff);
+        }
+    } else if (magnitude.back() & 0x80) {
+        magnitude.push_back(0);
+    }
+
+    out->assign(magnitude.rbegin(), magnitude.rend());
+}
+
+CassValueType
+TypeMapper::infer_type(const Local<Value>& value)
+{
+    if (node::Buffer::HasInstance(value)) {
+        return CASS_VALUE_TYPE_BLOB;
+    }
+    else if (value->IsInt32()) {
+        return CASS_VALUE_TYPE_INT;
+    }
+    else if (value -> IsNumber()) {
+        return CASS_VALUE_TYPE_DOUBLE;
+    }
+    else if (value->IsArray()) {
+        return CASS_VALUE_TYPE_LIST;
+    }
+    else if (value->IsString()) {
+        return CASS_VALUE_TYPE_VARCHAR;
+    }
+    else if (value -> IsBoolean()) {
+        return CASS_VALUE_TYPE_BOOLEAN;
+    }
+#ifdef HAVE_V8_BIGINT
+    else if (value->IsBigInt()) {
+        return CASS_VALUE_TYPE_BIGINT;
+    }
+#endif
+    else if (value -> IsObject()) {
+        return CASS_VALUE_TYPE_MAP;
+    }
+    else {
+        return CASS_VALUE_TYPE_UNKNOWN;
+    }
+}
+
+int
+TypeMapper::bind_statement_params(CassStatement* statement, Local<Array> params, Local<Object> param_types)
+{
+    for (u_int32_t i = 0; i < params->Length(); ++i) {
+        const Local<Value> arg = Nan::Get(params, i).ToLocalChecked();
+        CassValueType type = CASS_VALUE_TYPE_UNKNOWN;
+        u_int32_t encoding = 0;
+        if (!param_types.IsEmpty()) {
+            u_int32_t code = Nan::Get(param_types, i).ToLocalChecked()->Int32Value();
+            type = cass_type_from_code(code);
+            encoding = encoding_from_code(code);
+        }
+
+        if (! TypeMapper::bind_statement_param(statement, i, arg, type, encoding)) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int
+TypeMapper::bind_statement_params(CassStatement* statement,
+                                  Local<Array> params,
+                                  const std::vector<ParamBinder>& binders)
+{
+    u_int32_t length = params->Length();
+    if (length > binders.size()) {
+        return binders.size();
+    }
+
+    for (u_int32_t i = 0; i < length; ++i) {
+        const Local<Value> arg = Nan::Get(params, i).ToLocalChecked();
+        if (arg->IsNull()) {
+            cass_statement_bind_null(statement, i);
+            continue;
+        }
+
+        if (! binders[i].bind(statement, i, arg)) {
+            return i;
+        }
+    }
+
+    if (length < binders.size()) {
+        return length;
+    }
+
+    return -1;
+}
+
+bool
+TypeMapper::bind_statement_param(CassStatement* statement,
+                                 u_int32_t i,
+                                 const Local<Value>& value,
+                                 CassValueType given_type,
+                                 u_int32_t encoding)
+{
+    if (value->IsNull()) {
+        cass_statement_bind_null(statement, i);
+        return true;
+    }
+
+    CassValueType type = given_type == CASS_VALUE_TYPE_UNKNOWN ? infer_type(value) : given_type;
+    bind_fn fn = binder(type | encoding);
+    if (fn == NULL) {
+        return false;
+    }
+    return fn(statement, i, value);
+}
+
+// Each of these extracts a value of one cassandra type from a Javascript
+// value for binding or appending to a collection. They return false if the
+// value has the wrong type or doesn't fit, so that a mistake fails the bind
+// instead of storing a converted value.
+
+static bool
+blob_from_value(const Local<Value>& value, const cass_byte_t** data, size_t* size)
+{
+    if (!node::Buffer::HasInstance(value)) {
+        return false;
+    }
+    *data = (const cass_byte_t*) node::Buffer::Data(value);
+    *size = node::Buffer::Length(value);
+    return true;
+}
+
+static bool
+int32_from_value(const Local<Value>& value, cass_int32_t* result)
+{
+    if (!value->IsInt32()) {
+        return false;
+    }
+    *result = Nan::To<int32_t>(value).FromJust();
+    return true;
+}
+
+// Get a 64 bit value from a BigInt (where supported) or an integral Number,
+// returning false if the value doesn't fit.
+static bool
+int64_from_value(const Local<Value>& value, cass_int64_t* result)
+{
+#ifdef HAVE_V8_BIGINT
+    if (value->IsBigInt()) {
+        bool lossless;
+        *result = value.As<BigInt>()->Int64Value(&lossless);
+        return lossless;
+    }
+#endif
+    if (!value->IsNumber()) {
+        return false;
+    }
+    // The range check also rejects NaN
+    double number = Nan::To<double>(value).FromJust();
+    if (!(number >= -9223372036854775808.0 && number < 9223372036854775808.0) ||
+        number != floor(number))
+    {
+        return false;
+    }
+    *result = (cass_int64_t) number;
+    return true;
+}
+
+static bool
+double_from_value(const Local<Value>& value, cass_double_t* result)
+{
+    if (!value->IsNumber()) {
+        return false;
+    }
+    *result = Nan::To<double>(value).FromJust();
+    return true;
+}
+
+static bool
+bool_from_value(const Local<Value>& value, cass_bool_t* result)
+{
+    if (!value->IsBoolean()) {
+        return false;
+    }
+    *result = Nan::To<bool>(value).FromJust() ? cass_true : cass_false;
+    return true;
+}
+
+static bool
+uuid_from_value(const Local<Value>& value, CassUuid* uuid)
+{
+    if (!value->IsString()) {
+        return false;
+    }
+    String::Utf8Value str(value);
+    return uuid_from_string(*str, str.length(), uuid);
+}
+
+static bool
+inet_from_value(const Local<Value>& value, CassInet* inet)
+{
+    if (!value->IsString()) {
+        return false;
+    }
+    String::Utf8Value str(value);
+    return inet_from_string(*str, inet);
+}
+
+// Varints are given as a number or a string of decimal digits
+static bool
+varint_from_value(const Local<Value>& value, std::vector<cass_byte_t>* varint)
+{
+    if (!value->IsNumber() && !value->IsString()) {
+        return false;
+    }
+    String::Utf8Value str(value->ToString());
+    bool negative;
+    std::string digits;
+    cass_int32_t scale;
+    if (!parse_decimal(*str, str.length(), &negative, &digits, &scale) || scale > 0) {
+        return false;
+    }
+    if (!digits.empty()) {
+        digits.append(-scale, '0');
+    }
+    digits_to_varint(digits, negative, varint);
+    return true;
+}
+
+// Decimals are given as a number or a string, to preserve the precision
+static bool
+decimal_from_value(const Local<Value>& value, std::vector<cass_byte_t>* varint,
+                   cass_int32_t* scale)
+{
+    if (!value->IsNumber() && !value->IsString()) {
+        return false;
+    }
+    String::Utf8Value str(value->ToString());
+    bool negative;
+    std::string digits;
+    if (!parse_decimal(*str, str.length(), &negative, &digits, scale)) {
+        return false;
+    }
+    digits_to_varint(digits, negative, varint);
+    return true;
+}
+
+static bool
+bind_blob(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    const cass_byte_t* data;
+    size_t size;
+    if (!blob_from_value(value, &data, &size)) {
+        return false;
+    }
+    cass_statement_bind_bytes(statement, i, data, size);
+    return true;
+}
+
+static bool
+bind_double(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_double_t doubleValue;
+    if (!double_from_value(value, &doubleValue)) {
+        return false;
+    }
+    cass_statement_bind_double(statement, i, doubleValue);
+    return true;
+}
+
+static bool
+bind_float(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_double_t doubleValue;
+    if (!double_from_value(value, &doubleValue)) {
+        return false;
+    }
+    cass_statement_bind_float(statement, i, (cass_float_t) doubleValue);
+    return true;
+}
+
+static bool
+bind_uuid(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    CassUuid uuid;
+    if (!uuid_from_value(value, &uuid)) {
+        return false;
+    }
+    cass_statement_bind_uuid(statement, i, uuid);
+    return true;
+}
+
+static bool
+bind_inet(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    CassInet inet;
+    if (!inet_from_value(value, &inet)) {
+        return false;
+    }
+    cass_statement_bind_inet(statement, i, inet);
+    return true;
+}
+
+// Varints may also be given as a Buffer holding the encoded value
+static bool
+bind_varint(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    if (node::Buffer::HasInstance(value)) {
+        return bind_blob(statement, i, value);
+    }
+
+    std::vector<cass_byte_t> varint;
+    if (!varint_from_value(value, &varint)) {
+        return false;
+    }
+    cass_statement_bind_bytes(statement, i, &varint[0], varint.size());
+    return true;
+}
+
+static bool
+bind_decimal(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    std::vector<cass_byte_t> varint;
+    cass_int32_t scale;
+    if (!decimal_from_value(value, &varint, &scale)) {
+        return false;
+    }
+    cass_statement_bind_decimal(statement, i, &varint[0], varint.size(), scale);
+    return true;
+}
+
+static bool
+bind_string(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    if (!value->IsString()) {
+        return false;
+    }
+    String::Utf8Value str(value);
+    cass_statement_bind_string_n(statement, i, *str, str.length());
+    return true;
+}
+
+static bool
+bind_int(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_int32_t intValue;
+    if (!int32_from_value(value, &intValue)) {
+        return false;
+    }
+    cass_statement_bind_int32(statement, i, intValue);
+    return true;
+}
+
+static bool
+bind_bigint(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_int64_t intValue;
+    if (!int64_from_value(value, &intValue)) {
+        return false;
+    }
+    cass_statement_bind_int64(statement, i, intValue);
+    return true;
+}
+
+static PersistentString low_str("low");
+static PersistentString high_str("high");
+
+static bool
+bind_bigint_object(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    // Bigints passed in as {'low': <lowInt>, 'high': <highInt>}
+    if (!value->IsObject()) {
+        return false;
+    }
+    Local<Object> obj = value.As<Object>();
+    int lowVal = Nan::Get(obj, low_str).ToLocalChecked()->ToNumber()->NumberValue();
+    int highVal = Nan::Get(obj, high_str).ToLocalChecked()->ToNumber()->NumberValue();
+
+    cass_int64_t intValue = ((long)highVal) << 32 | lowVal;
+    cass_statement_bind_int64(statement, i, intValue);
+    return true;
+}
+
+static bool
+bind_boolean(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_bool_t booleanValue;
+    if (!bool_from_value(value, &booleanValue)) {
+        return false;
+    }
+    cass_statement_bind_bool(statement, i, booleanValue);
+    return true;
+}
+
+// Append each element of the array to a new collection with the given
+// function, or with type inference if it's NULL
+static CassCollection*
+collection_from_array(const Local<Value>& value, CassCollectionType type,
+                      TypeMapper::append_fn append)
+{
+    if (!value->IsArray()) {
+        return NULL;
+    }
+    Local<Array> array = value.As<Array>();
+    size_t length = array->Length();
+    CassCollection* collection = cass_collection_new(type, length);
+    for (size_t j = 0; j < length; ++j) {
+        Local<Value> val = Nan::Get(array, j).ToLocalChecked();
+        bool ok = append ? append(collection, val)
+                         : TypeMapper::append_collection(collection, val);
+        if (!ok) {
+            cass_collection_free(collection);
+            return NULL;
+        }
+    }
+    return collection;
+}
+
+// Map keys are property names, which are strings. Keys of a numeric type
+// are converted back to numbers.
+static Local<Value>
+map_key(const Local<Value>& key, CassValueType type)
+{
+    switch (type) {
+    case CASS_VALUE_TYPE_INT:
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_FLOAT:
+    case CASS_VALUE_TYPE_DOUBLE:
+        return Nan::To<Number>(key).ToLocalChecked();
+    default:
+        return key;
+    }
+}
+
+// Append each key and value of the object to a new map with the given
+// functions, or with type inference if they're NULL
+static CassCollection*
+map_from_object(const Local<Value>& value,
+                TypeMapper::append_fn append_key, CassValueType key_type,
+                TypeMapper::append_fn append_value)
+{
+    if (!value->IsObject() || value->IsArray()) {
+        return NULL;
+    }
+    Local<Object> obj = value.As<Object>();
+    Local<Array> keys = Nan::GetOwnPropertyNames(obj).ToLocalChecked();
+    CassCollection* collection = cass_collection_new(CASS_COLLECTION_TYPE_MAP, keys->Length());
+    for (size_t j = 0; j < keys->Length(); j++) {
+        Local<Value> key = Nan::Get(keys, j).ToLocalChecked();
+        Local<Value> val = Nan::Get(obj, key).ToLocalChecked();
+        bool ok = append_key ? append_key(collection, map_key(key, key_type))
+                             : TypeMapper::append_collection(collection, key);
+        if (ok) {
+            ok = append_value ? append_value(collection, val)
+                              : TypeMapper::append_collection(collection, val);
+        }
+        if (!ok) {
+            cass_collection_free(collection);
+            return NULL;
+        }
+    }
+    return collection;
+}
+
+static bool
+bind_collection(CassStatement* statement, u_int32_t i, CassCollection* collection)
+{
+    if (collection == NULL) {
+        return false;
+    }
+    cass_statement_bind_collection(statement, i, collection);
+    cass_collection_free(collection);
+    return true;
+}
+
+static bool
+bind_list(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    return bind_collection(statement, i,
+        collection_from_array(value, CASS_COLLECTION_TYPE_LIST, NULL));
+}
+
+static bool
+bind_set(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    return bind_collection(statement, i,
+        collection_from_array(value, CASS_COLLECTION_TYPE_SET, NULL));
+}
+
+static bool
+bind_map(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    return bind_collection(statement, i,
+        map_from_object(value, NULL, CASS_VALUE_TYPE_UNKNOWN, NULL));
+}
+
+// Return the bind function that only accepts values of the Javascript type
+// expected for the given cassandra type, as used for the parameters of a
+// prepared statement
+static TypeMapper::bind_fn
+checked_binder(u_int32_t code)
+{
+    switch(cass_type_from_code(code)) {
+    case CASS_VALUE_TYPE_BLOB:
+        return bind_blob;
+    case CASS_VALUE_TYPE_DOUBLE:
+        return bind_double;
+    case CASS_VALUE_TYPE_FLOAT:
+        return bind_float;
+    case CASS_VALUE_TYPE_LIST:
+        return bind_list;
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+        return bind_string;
+    case CASS_VALUE_TYPE_INT:
+        return bind_int;
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_BIGINT:
+        if (encoding_from_code(code) == BIGINT_AS_OBJECT) {
+            return bind_bigint_object;
+        }
+#ifndef HAVE_V8_BIGINT
+        if (encoding_from_code(code) == BIGINT_AS_BIGINT) {
+            return NULL;
+        }
+#endif
+        // Numbers and BigInts are accepted either way
+        return bind_bigint;
+    case CASS_VALUE_TYPE_BOOLEAN:
+        return bind_boolean;
+    case CASS_VALUE_TYPE_MAP:
+        return bind_map;
+    case CASS_VALUE_TYPE_SET:
+        return bind_set;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+        return bind_uuid;
+    case CASS_VALUE_TYPE_INET:
+        return bind_inet;
+    case CASS_VALUE_TYPE_VARINT:
+        return bind_varint;
+    case CASS_VALUE_TYPE_DECIMAL:
+        return bind_decimal;
+    case CASS_VALUE_TYPE_UNKNOWN:
+    case CASS_VALUE_TYPE_CUSTOM:
+    default:
+        return NULL;
+    }
+}
+
+// The bind functions for params given with param_types or by inference
+// convert numbers, strings and booleans the way the ToNumber, ToString and
+// ToBoolean operators do, so for instance a Date can be bound to a timestamp
+// and a number to a string.
+
+static bool
+bind_double_converted(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_double_t doubleValue = value->ToNumber()->NumberValue();
+    cass_statement_bind_double(statement, i, doubleValue);
+    return true;
+}
+
+static bool
+bind_float_converted(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_float_t floatValue = value->ToNumber()->NumberValue();
+    cass_statement_bind_float(statement, i, floatValue);
+    return true;
+}
+
+static bool
+bind_string_converted(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    String::Utf8Value str(value->ToString());
+    cass_statement_bind_string_n(statement, i, *str, str.length());
+    return true;
+}
+
+static bool
+bind_int_converted(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_int32_t intValue = value->ToNumber()->Int32Value();
+    cass_statement_bind_int32(statement, i, intValue);
+    return true;
+}
+
+static bool
+bind_bigint_converted(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+#ifdef HAVE_V8_BIGINT
+    if (value->IsBigInt()) {
+        return bind_bigint(statement, i, value);
+    }
+#endif
+    cass_int64_t intValue = value->ToNumber()->IntegerValue();
+    cass_statement_bind_int64(statement, i, intValue);
+    return true;
+}
+
+static bool
+bind_boolean_converted(CassStatement* statement, u_int32_t i, const Local<Value>& value)
+{
+    cass_bool_t booleanValue = (Nan::To<bool>(value).FromJust() ? cass_true : cass_false);
+    cass_statement_bind_bool(statement, i, booleanValue);
+    return true;
+}
+
+TypeMapper::bind_fn
+TypeMapper::binder(u_int32_t code)
+{
+    switch(cass_type_from_code(code)) {
+    case CASS_VALUE_TYPE_DOUBLE:
+        return bind_double_converted;
+    case CASS_VALUE_TYPE_FLOAT:
+        return bind_float_converted;
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+        return bind_string_converted;
+    case CASS_VALUE_TYPE_INT:
+        return bind_int_converted;
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_BIGINT: {
+        // Values given as {low, high} objects aren't converted
+        bind_fn fn = checked_binder(code);
+        return fn == bind_bigint ? bind_bigint_converted : fn;
+    }
+    case CASS_VALUE_TYPE_BOOLEAN:
+        return bind_boolean_converted;
+    default:
+        return checked_binder(code);
+    }
+}
+
+static bool
+append_blob(CassCollection* collection, const Local<Value>& value)
+{
+    const cass_byte_t* data;
+    size_t size;
+    return blob_from_value(value, &data, &size) &&
+        cass_collection_append_bytes(collection, data, size) == CASS_OK;
+}
+
+static bool
+append_int(CassCollection* collection, const Local<Value>& value)
+{
+    cass_int32_t intValue;
+    return int32_from_value(value, &intValue) &&
+        cass_collection_append_int32(collection, intValue) == CASS_OK;
+}
+
+static bool
+append_bigint(CassCollection* collection, const Local<Value>& value)
+{
+    cass_int64_t intValue;
+    return int64_from_value(value, &intValue) &&
+        cass_collection_append_int64(collection, intValue) == CASS_OK;
+}
+
+static bool
+append_double(CassCollection* collection, const Local<Value>& value)
+{
+    cass_double_t doubleValue;
+    return double_from_value(value, &doubleValue) &&
+        cass_collection_append_double(collection, doubleValue) == CASS_OK;
+}
+
+static bool
+append_float(CassCollection* collection, const Local<Value>& value)
+{
+    cass_double_t doubleValue;
+    return double_from_value(value, &doubleValue) &&
+        cass_collection_append_float(collection, (cass_float_t) doubleValue) == CASS_OK;
+}
+
+static bool
+append_boolean(CassCollection* collection, const Local<Value>& value)
+{
+    cass_bool_t booleanValue;
+    return bool_from_value(value, &booleanValue) &&
+        cass_collection_append_bool(collection, booleanValue) == CASS_OK;
+}
+
+static bool
+append_string(CassCollection* collection, const Local<Value>& value)
+{
+    if (!value->IsString()) {
+        return false;
+    }
+    String::Utf8Value str(value);
+    return cass_collection_append_string_n(collection, *str, str.length()) == CASS_OK;
+}
+
+static bool
+append_uuid(CassCollection* collection, const Local<Value>& value)
+{
+    CassUuid uuid;
+    return uuid_from_value(value, &uuid) &&
+        cass_collection_append_uuid(collection, uuid) == CASS_OK;
+}
 
-CassValueType
-TypeMapper::infer_type(const Local<Value>& value)
+static bool
+append_inet(CassCollection* collection, const Local<Value>& value)
+{
+    CassInet inet;
+    return inet_from_value(value, &inet) &&
+        cass_collection_append_inet(collection, inet) == CASS_OK;
+}
+
+static bool
+append_varint(CassCollection* collection, const Local<Value>& value)
 {
     if (node::Buffer::HasInstance(value)) {
-        return CASS_VALUE_TYPE_BLOB;
-    }
-    else if (value->IsInt32()) {
-        return CASS_VALUE_TYPE_INT;
-    }
-    else if (value -> IsNumber()) {
-        return CASS_VALUE_TYPE_DOUBLE;
+        return append_blob(collection, value);
     }
-    else if (value->IsArray()) {
-        return CASS_VALUE_TYPE_LIST;
+    std::vector<cass_byte_t> varint;
+    return varint_from_value(value, &varint) &&
+        cass_collection_append_bytes(collection, &varint[0], varint.size()) == CASS_OK;
+}
+
+static bool
+append_decimal(CassCollection* collection, const Local<Value>& value)
+{
+    std::vector<cass_byte_t> varint;
+    cass_int32_t scale;
+    return decimal_from_value(value, &varint, &scale) &&
+        cass_collection_append_decimal(collection, &varint[0], varint.size(),
+                                       scale) == CASS_OK;
+}
+
+TypeMapper::append_fn
+TypeMapper::appender(CassValueType type)
+{
+    switch(type) {
+    case CASS_VALUE_TYPE_BLOB:
+        return append_blob;
+    case CASS_VALUE_TYPE_DOUBLE:
+        return append_double;
+    case CASS_VALUE_TYPE_FLOAT:
+        return append_float;
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+        return append_string;
+    case CASS_VALUE_TYPE_INT:
+        return append_int;
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_BIGINT:
+        return append_bigint;
+    case CASS_VALUE_TYPE_BOOLEAN:
+        return append_boolean;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+        return append_uuid;
+    case CASS_VALUE_TYPE_INET:
+        return append_inet;
+    case CASS_VALUE_TYPE_VARINT:
+        return append_varint;
+    case CASS_VALUE_TYPE_DECIMAL:
+        return append_decimal;
+    default:
+        // Nested collections aren't supported
+        return NULL;
     }
-    else if (value->IsString()) {
-        return CASS_VALUE_TYPE_VARCHAR;
+}
+
+TypeMapper::ParamBinder
+TypeMapper::param_binder(CassValueType type, CassValueType primary_type,
+                         CassValueType secondary_type)
+{
+    ParamBinder result;
+    result.type_ = type;
+    switch (type) {
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_SET:
+        result.primary_ = appender(primary_type);
+        break;
+    case CASS_VALUE_TYPE_MAP:
+        result.key_type_ = primary_type;
+        result.primary_ = appender(primary_type);
+        result.secondary_ = appender(secondary_type);
+        if (result.secondary_ == NULL) {
+            result.primary_ = NULL;
+        }
+        break;
+    default:
+        result.bind_ = checked_binder(type);
+        break;
     }
-    else if (value -> IsBoolean()) {
-        return CASS_VALUE_TYPE_BOOLEAN;
+    return result;
+}
+
+bool
+TypeMapper::ParamBinder::bind(CassStatement* statement, u_int32_t i,
+                              const Local<Value>& value) const
+{
+    if (bind_ != NULL) {
+        return bind_(statement, i, value);
     }
-    else if (value -> IsObject()) {
-        return CASS_VALUE_TYPE_MAP;
+    if (primary_ == NULL) {
+        return false;
     }
-    else {
-        return CASS_VALUE_TYPE_UNKNOWN;
+
+    switch (type_) {
+    case CASS_VALUE_TYPE_LIST:
+        return bind_collection(statement, i,
+            collection_from_array(value, CASS_COLLECTION_TYPE_LIST, primary_));
+    case CASS_VALUE_TYPE_SET:
+        return bind_collection(statement, i,
+            collection_from_array(value, CASS_COLLECTION_TYPE_SET, primary_));
+    case CASS_VALUE_TYPE_MAP:
+        return bind_collection(statement, i,
+            map_from_object(value, primary_, key_type_, secondary_));
+    default:
+        return false;
     }
 }
 
-int
-TypeMapper::bind_statement_params(CassStatement* statement, Local<Array> params, Local<Object> param_types)
+// Append the Javascript value to the given collection using the appender for
+// its inferred type
+bool
+TypeMapper::append_collection(CassCollection* collection, const Local<Value>& value)
 {
-    for (u_int32_t i = 0; i < params->Length(); ++i) {
-        const Local<Value> arg = Nan::Get(params, i).ToLocalChecked();
-        CassValueType type = CASS_VALUE_TYPE_UNKNOWN;
-        u_int32_t encoding = 0;
-        if (!param_types.IsEmpty()) {
-            u_int32_t code = Nan::Get(param_types, i).ToLocalChecked()->Int32Value();
-            type = cass_type_from_code(code);
-            encoding = encoding_from_code(code);
-        }
+    append_fn fn = appender(infer_type(value));
+    return fn != NULL && fn(collection, value);
+}
 
-        if (! TypeMapper::bind_statement_param(statement, i, arg, type, encoding)) {
-            return i;
-        }
+bool
+TypeMapper::is_scalar(CassValueType type)
+{
+    switch(type) {
+    case CASS_VALUE_TYPE_BLOB:
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+    case CASS_VALUE_TYPE_INT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_DOUBLE:
+    case CASS_VALUE_TYPE_FLOAT:
+    case CASS_VALUE_TYPE_BOOLEAN:
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+    case CASS_VALUE_TYPE_INET:
+    case CASS_VALUE_TYPE_VARINT:
+    case CASS_VALUE_TYPE_DECIMAL:
+        return true;
+    default:
+        return false;
     }
-
-    return -1;
 }
 
 bool
-TypeMapper::bind_statement_param(CassStatement* statement,
-                                 u_int32_t i,
-                                 const Local<Value>& value,
-                                 CassValueType given_type,
-                                 u_int32_t encoding)
+TypeMapper::decode_value(DecodedValue* result,
+                         u_int32_t code,
+                         const CassValue* value)
 {
-    if (value->IsNull()) {
-        cass_statement_bind_null(statement, i);
+    CassValueType type = cass_type_from_code(code);
+
+    if (value == NULL || cass_value_is_null(value)) {
+        result->is_null_ = true;
         return true;
     }
+    result->is_null_ = false;
 
-    CassValueType type = given_type == CASS_VALUE_TYPE_UNKNOWN ? infer_type(value) : given_type;
     switch(type) {
     case CASS_VALUE_TYPE_BLOB: {
-        Local<Object> obj = value->ToObject();
-        cass_statement_bind_bytes(statement, i,
-            (cass_byte_t*) node::Buffer::Data(obj),
-            node::Buffer::Length(obj));
-        return true;
-    }
-    case CASS_VALUE_TYPE_DOUBLE: {
-        cass_double_t doubleValue = value->ToNumber()->NumberValue();
-        cass_statement_bind_double(statement, i, doubleValue);
-        return true;
-    }
-    case CASS_VALUE_TYPE_FLOAT: {
-        cass_float_t floatValue = value->ToNumber()->NumberValue();
-        cass_statement_bind_float(statement, i, floatValue);
-        return true;
-    }
-    case CASS_VALUE_TYPE_LIST: {
-        Local<Value> val = value;
-        Local<Array> array = val.As<Array>();
-        size_t length = array->Length();
-        CassCollection* list = cass_collection_new(CASS_COLLECTION_TYPE_LIST, array->Length());
-        for (size_t j = 0; j < length; ++j) {
-            Local<Value> val = Nan::Get(array, j).ToLocalChecked();
-            append_collection(list, val);
-        }
-        cass_statement_bind_collection(statement, i, list);
-        cass_collection_free(list);
+        const cass_byte_t* data;
+        if (cass_value_get_bytes(value, &data, &result->size_) != CASS_OK) {
+            return false;
+        }
+        result->data_ = (const char*)data;
         return true;
     }
     case CASS_VALUE_TYPE_ASCII:
     case CASS_VALUE_TYPE_TEXT:
-    case CASS_VALUE_TYPE_VARCHAR: {
-        String::Utf8Value str(value->ToString());
-        cass_statement_bind_string_n(statement, i, *str, str.length());
-        return true;
-    }
-    case CASS_VALUE_TYPE_INT: {
-        cass_int32_t intValue = value->ToNumber()->Int32Value();
-        cass_statement_bind_int32(statement, i, intValue);
-        return true;
-    }
+    case CASS_VALUE_TYPE_VARCHAR:
+        return cass_value_get_string(value, &result->data_, &result->size_) == CASS_OK;
+    case CASS_VALUE_TYPE_INT:
+        return cass_value_get_int32(value, &result->int32_) == CASS_OK;
     case CASS_VALUE_TYPE_COUNTER:
     case CASS_VALUE_TYPE_TIMESTAMP:
-    case CASS_VALUE_TYPE_BIGINT: {
-        cass_int64_t intValue;
-        if (encoding == BIGINT_AS_OBJECT) {
-            // Bigints passed in as {'low': <lowInt>, 'high': <highInt>}
-            Local<Object> obj = value->ToObject();
-            Local<String> lowKey = Nan::New<String>("low").ToLocalChecked();
-            Local<String> highKey = Nan::New<String>("high").ToLocalChecked();
-            int lowVal = obj->Get(lowKey)->ToNumber()->NumberValue();
-            int highVal = obj->Get(highKey)->ToNumber()->NumberValue();
-
-            intValue = ((long)highVal) << 32 | lowVal;
-        } else {
-            intValue = value->ToNumber()->IntegerValue();
+    case CASS_VALUE_TYPE_BIGINT:
+        return cass_value_get_int64(value, &result->int64_) == CASS_OK;
+    case CASS_VALUE_TYPE_DOUBLE:
+        return cass_value_get_double(value, &result->double_) == CASS_OK;
+    case CASS_VALUE_TYPE_FLOAT:
+        return cass_value_get_float(value, &result->float_) == CASS_OK;
+    case CASS_VALUE_TYPE_BOOLEAN:
+        return cass_value_get_bool(value, &result->bool_) == CASS_OK;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+        return cass_value_get_uuid(value, &result->uuid_) == CASS_OK;
+    case CASS_VALUE_TYPE_INET:
+        return cass_value_get_inet(value, &result->inet_) == CASS_OK;
+    case CASS_VALUE_TYPE_VARINT: {
+        const cass_byte_t* data;
+        if (cass_value_get_bytes(value, &data, &result->size_) != CASS_OK) {
+            return false;
         }
-        cass_statement_bind_int64(statement, i, intValue);
+        result->data_ = (const char*)data;
         return true;
     }
-    case CASS_VALUE_TYPE_BOOLEAN: {
-        cass_bool_t booleanValue = (Nan::To<bool>(value).FromJust() ? cass_true : cass_false);
-        cass_statement_bind_bool(statement, i, booleanValue);
-        return true;
-    }
-    case CASS_VALUE_TYPE_MAP: {
-        Local<Object> obj = value->ToObject();
-        Local<Array> keys = Nan::GetOwnPropertyNames(obj).ToLocalChecked();
-        CassCollection* cassObj = cass_collection_new(CASS_COLLECTION_TYPE_MAP, keys->Length());
-        for (size_t j = 0; j < keys->Length(); j++) {
-            Local<Value> key = Nan::Get(keys, j).ToLocalChecked();
-            Local<Value> val = Nan::Get(obj, key).ToLocalChecked();
-            if (!append_collection(cassObj, key) || !append_collection(cassObj, val)) {
-                return false;
-            }
+    case CASS_VALUE_TYPE_DECIMAL: {
+        const cass_byte_t* data;
+        if (cass_value_get_decimal(value, &data, &result->size_, &result->int32_) != CASS_OK) {
+            return false;
         }
-        cass_statement_bind_collection(statement, i, cassObj);
-        cass_collection_free(cassObj);
+        result->data_ = (const char*)data;
         return true;
     }
-    case CASS_VALUE_TYPE_UNKNOWN:
-    case CASS_VALUE_TYPE_CUSTOM:
-    case CASS_VALUE_TYPE_DECIMAL:
-    case CASS_VALUE_TYPE_UUID:
-    case CASS_VALUE_TYPE_VARINT:
-    case CASS_VALUE_TYPE_TIMEUUID:
-    case CASS_VALUE_TYPE_INET:
-    case CASS_VALUE_TYPE_SET:
     default:
         return false;
     }
 }
 
-// Append the Javascript value to the given collection
 bool
-TypeMapper::append_collection(CassCollection* collection, const Local<Value>& value)
+TypeMapper::is_ascii(const char* data, size_t size)
 {
-    CassValueType type = infer_type(value);
-    switch(type) {
-    case CASS_VALUE_TYPE_BLOB: {
-        Local<Object> obj = value->ToObject();
-        cass_collection_append_bytes(collection,
-            (cass_byte_t*)node::Buffer::Data(obj),
-            node::Buffer::Length(obj));
-        return true;
-    }
-    case CASS_VALUE_TYPE_INT: {
-        cass_int32_t intValue = value->ToNumber()->Int32Value();
-        cass_collection_append_int32(collection, intValue);
-        return true;
-    }
-    case CASS_VALUE_TYPE_COUNTER:
-    case CASS_VALUE_TYPE_TIMESTAMP: {
-        cass_int64_t intValue = value->ToNumber()->IntegerValue();
-        cass_collection_append_int64(collection, intValue);
-        return true;
-    }
-    case CASS_VALUE_TYPE_DOUBLE: {
-        cass_double_t doubleValue = value->ToNumber()->NumberValue();
-        cass_collection_append_double(collection, doubleValue);
-        return true;
+    // Check a word at a time, which the compiler is free to vectorize
+    const cass_uint64_t high_bits = 0x8080808080808080ULL;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        cass_uint64_t word;
+        memcpy(&word, data + i, 8);
+        if (word & high_bits) {
+            return false;
+        }
     }
-    case CASS_VALUE_TYPE_FLOAT: {
-        cass_float_t floatValue = value->ToNumber()->NumberValue();
-        cass_collection_append_float(collection, floatValue);
-        return true;
+    for (; i < size; ++i) {
+        if (data[i] & 0x80) {
+            return false;
+        }
     }
-    case CASS_VALUE_TYPE_BOOLEAN: {
-        cass_bool_t booleanValue = (Nan::To<bool>(value).FromJust() ? cass_true : cass_false);
-        cass_collection_append_bool(collection, booleanValue);
-        return true;
+    return true;
+}
+
+Local<String>
+TypeMapper::new_string(const char* data, size_t size, CassValueType type)
+{
+    // The server validates ascii columns so they never need checking
+    if (type == CASS_VALUE_TYPE_ASCII || is_ascii(data, size)) {
+        return Nan::NewOneByteString((const uint8_t*)data, size).ToLocalChecked();
     }
-    case CASS_VALUE_TYPE_ASCII:
-    case CASS_VALUE_TYPE_TEXT:
-    case CASS_VALUE_TYPE_VARCHAR: {
-        String::Utf8Value str(value->ToString());
-        cass_collection_append_string_n(collection, *str, str.length());
-        return true;
+    return Nan::New<String>(data, size).ToLocalChecked();
+}
+
+Local<String>
+TypeMapper::new_internalized_string(const char* data, size_t size, CassValueType type)
+{
+    bool ascii = type == CASS_VALUE_TYPE_ASCII || is_ascii(data, size);
+#if defined(HAVE_V8_NEW_STRING_TYPE)
+    Isolate* isolate = Isolate::GetCurrent();
+    if (ascii) {
+        return String::NewFromOneByte(isolate, (const uint8_t*)data,
+            NewStringType::kInternalized, size).ToLocalChecked();
     }
-    case CASS_VALUE_TYPE_UNKNOWN:
-    case CASS_VALUE_TYPE_CUSTOM:
-    case CASS_VALUE_TYPE_BIGINT:
-    case CASS_VALUE_TYPE_DECIMAL:
-    case CASS_VALUE_TYPE_VARINT:
-    case CASS_VALUE_TYPE_INET:
-    case CASS_VALUE_TYPE_LIST:
-    case CASS_VALUE_TYPE_MAP:
-    case CASS_VALUE_TYPE_SET:
-    case CASS_VALUE_TYPE_TIMEUUID:
-    case CASS_VALUE_TYPE_UUID:
-    default:
-        return false;
+    return String::NewFromUtf8(isolate, data,
+        NewStringType::kInternalized, size).ToLocalChecked();
+#elif NODE_MODULE_VERSION >= NODE_0_12_MODULE_VERSION
+    Isolate* isolate = Isolate::GetCurrent();
+    if (ascii) {
+        return String::NewFromOneByte(isolate, (const uint8_t*)data,
+            String::kInternalizedString, size);
     }
+    return String::NewFromUtf8(isolate, data, String::kInternalizedString, size);
+#else
+    // Symbols are what v8 3.14 calls internalized strings
+    (void)ascii;
+    return String::NewSymbol(data, size);
+#endif
 }
 
 bool
-TypeMapper::v8_from_cassandra(v8::Local<v8::Value>* result,
-                              u_int32_t code,
-                              const CassValue* value)
+TypeMapper::v8_from_decoded(v8::Local<v8::Value>* result,
+                            u_int32_t code,
+                            const DecodedValue& value,
+                            SharedResult* owner)
 {
     CassValueType type = cass_type_from_code(code);
     u_int32_t encoding = encoding_from_code(code);
 
-    if (value == NULL || cass_value_is_null(value)) {
+    if (value.is_null_) {
         *result = Nan::Null();
         return true;
     }
 
     switch(type) {
     case CASS_VALUE_TYPE_BLOB: {
-        const cass_byte_t* data;
-        size_t size;
-        if (cass_value_get_bytes(value, &data, &size) != CASS_OK) {
-            return false;
+        if (encoding == BLOB_ZERO_COPY && owner != NULL && value.size_ >= ZERO_COPY_MIN_SIZE) {
+            // Point the buffer straight into the response body, keeping the
+            // result alive until the buffer is collected.
+            owner->ref();
+            *result = Nan::NewBuffer((char*)value.data_, value.size_, release_shared_result, owner).ToLocalChecked();
+            return true;
         }
-        *result = Nan::CopyBuffer((char*)data, size).ToLocalChecked();
+        *result = Nan::CopyBuffer(value.data_, value.size_).ToLocalChecked();
         return true;
     }
     case CASS_VALUE_TYPE_ASCII:
     case CASS_VALUE_TYPE_TEXT:
     case CASS_VALUE_TYPE_VARCHAR: {
-        const char* data;
-        size_t size;
-        if (cass_value_get_string(value, &data, &size) != CASS_OK) {
-            return false;
-        }
-        *result = Nan::New<String>(data, size).ToLocalChecked();
+        *result = new_string(value.data_, value.size_, type);
         return true;
     }
     case CASS_VALUE_TYPE_INT: {
-        cass_int32_t intValue;
-        if (cass_value_get_int32(value, &intValue) != CASS_OK) {
-            return false;
-        }
-        *result = Nan::New<Number>(intValue);
+        *result = Nan::New<Number>(value.int32_);
         return true;
     }
     case CASS_VALUE_TYPE_COUNTER:
     case CASS_VALUE_TYPE_TIMESTAMP:
     case CASS_VALUE_TYPE_BIGINT: {
-        // Get the bigint value
-        cass_int64_t intValue;
-        if (cass_value_get_int64(value, &intValue) != CASS_OK) {
-            return false;
-        }
+        cass_int64_t intValue = value.int64_;
         if (encoding == BIGINT_AS_OBJECT) {
             // Because Node's native Number object only goes up to 53bit, unpack
             // the 64bit value into two 32bit values who can be passed up to
@@ -286,43 +1358,87 @@ TypeMapper::v8_from_cassandra(v8::Local<v8::Value>* result,
             //         "low": <lowValue>,
             //         "high": <highValue>
             //     }
-            Local<String> lowKey = Nan::New<String>("low").ToLocalChecked();
-            Local<String> highKey = Nan::New<String>("high").ToLocalChecked();
             Local<Number> lowVal = Nan::New<Number>((double)low);
             Local<Number> highVal = Nan::New<Number>((double)high);
             Local<Object> obj = Nan::New<Object>();
-            obj->Set(lowKey, lowVal);
-            obj->Set(highKey, highVal);
+            Nan::Set(obj, low_str, lowVal);
+            Nan::Set(obj, high_str, highVal);
             *result = obj;
+        } else if (encoding == BIGINT_AS_BIGINT) {
+#ifdef HAVE_V8_BIGINT
+            *result = BigInt::New(Isolate::GetCurrent(), intValue);
+#else
+            return false;
+#endif
         } else {
             *result = Nan::New<Number>((double)intValue);
         }
         return true;
     }
     case CASS_VALUE_TYPE_DOUBLE: {
-        cass_double_t doubleValue;
-        if (cass_value_get_double(value, &doubleValue) != CASS_OK) {
-            return false;
-        }
-        *result = Nan::New<Number>(doubleValue);
+        *result = Nan::New<Number>(value.double_);
         return true;
     }
     case CASS_VALUE_TYPE_FLOAT: {
-        cass_float_t floatValue;
-        if (cass_value_get_float(value, &floatValue) != CASS_OK) {
-            return false;
-        }
-        *result = Nan::New<Number>(floatValue);
+        *result = Nan::New<Number>(value.float_);
         return true;
     }
     case CASS_VALUE_TYPE_BOOLEAN: {
-        cass_bool_t booleanValue;
-        if (cass_value_get_bool(value, &booleanValue) != CASS_OK) {
+        *result = value.bool_ ? Nan::True() : Nan::False();
+        return true;
+    }
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID: {
+        char buf[CASS_UUID_STRING_LENGTH];
+        uuid_to_string(value.uuid_, buf);
+        *result = Nan::NewOneByteString((const uint8_t*)buf, CASS_UUID_STRING_LENGTH - 1).ToLocalChecked();
+        return true;
+    }
+    case CASS_VALUE_TYPE_INET: {
+        char buf[CASS_INET_STRING_LENGTH];
+        size_t length = inet_to_string(value.inet_, buf);
+        if (length == 0) {
             return false;
         }
-        *result = booleanValue ? Nan::True() : Nan::False();
+        *result = Nan::NewOneByteString((const uint8_t*)buf, length).ToLocalChecked();
+        return true;
+    }
+    case CASS_VALUE_TYPE_VARINT:
+    case CASS_VALUE_TYPE_DECIMAL: {
+        std::string str;
+        if (type == CASS_VALUE_TYPE_VARINT) {
+            varint_to_string((const cass_byte_t*)value.data_, value.size_, &str);
+        } else {
+            decimal_to_string((const cass_byte_t*)value.data_, value.size_, value.int32_, &str);
+        }
+        *result = Nan::NewOneByteString((const uint8_t*)str.data(), str.size()).ToLocalChecked();
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool
+TypeMapper::v8_from_cassandra(v8::Local<v8::Value>* result,
+                              u_int32_t code,
+                              const CassValue* value,
+                              SharedResult* owner)
+{
+    CassValueType type = cass_type_from_code(code);
+
+    if (value == NULL || cass_value_is_null(value)) {
+        *result = Nan::Null();
         return true;
     }
+
+    if (is_scalar(type)) {
+        DecodedValue decoded;
+        return decode_value(&decoded, code, value) &&
+               v8_from_decoded(result, code, decoded, owner);
+    }
+
+    switch(type) {
     case CASS_VALUE_TYPE_MAP: {
         Local<Object> obj = Nan::New<Object>();
         CassIterator* iterator = cass_iterator_from_map(value);
@@ -333,6 +1449,7 @@ TypeMapper::v8_from_cassandra(v8::Local<v8::Value>* result,
             const CassValue* val = cass_iterator_get_map_value(iterator);
             Local<Value> a, b;
             if (!v8_from_cassandra(&a, keyType, key) || !v8_from_cassandra(&b, valueType, val)) {
+                cass_iterator_free(iterator);
                 return false;
             }
             Nan::Set(obj, a, b);
@@ -341,15 +1458,27 @@ TypeMapper::v8_from_cassandra(v8::Local<v8::Value>* result,
         *result = obj;
         return true;
     }
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_SET: {
+        // Sets are returned as arrays too, in the order the server sent them
+        Local<Array> array = Nan::New<Array>(cass_value_item_count(value));
+        CassIterator* iterator = cass_iterator_from_collection(value);
+        CassValueType itemType = cass_value_primary_sub_type(value);
+        u_int32_t j = 0;
+        while (cass_iterator_next(iterator)) {
+            Local<Value> item;
+            if (!v8_from_cassandra(&item, itemType, cass_iterator_get_value(iterator))) {
+                cass_iterator_free(iterator);
+                return false;
+            }
+            Nan::Set(array, j++, item);
+        }
+        cass_iterator_free(iterator);
+        *result = array;
+        return true;
+    }
     case CASS_VALUE_TYPE_UNKNOWN:
     case CASS_VALUE_TYPE_CUSTOM:
-    case CASS_VALUE_TYPE_DECIMAL:
-    case CASS_VALUE_TYPE_UUID:
-    case CASS_VALUE_TYPE_VARINT:
-    case CASS_VALUE_TYPE_TIMEUUID:
-    case CASS_VALUE_TYPE_INET:
-    case CASS_VALUE_TYPE_LIST:
-    case CASS_VALUE_TYPE_SET:
     default:
         return false;
     }
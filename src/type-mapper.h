@@ -2,8 +2,45 @@
 #define _CASSANDRA_NATIVE_TYPE_MAPPER_H_
 
 #include <nan.h>
+#include <vector>
 #include "cassandra.h"
 
+// v8 exposes BigInt (and BigInt64Array) to native code as of 6.9
+#if V8_MAJOR_VERSION > 6 || (V8_MAJOR_VERSION == 6 && V8_MINOR_VERSION >= 9)
+#define HAVE_V8_BIGINT 1
+#endif
+
+// The string factories take a NewStringType and return a MaybeLocal as of
+// v8 4.3
+#if V8_MAJOR_VERSION > 4 || (V8_MAJOR_VERSION == 4 && V8_MINOR_VERSION >= 3)
+#define HAVE_V8_NEW_STRING_TYPE 1
+#endif
+
+class SharedResult;
+
+// A scalar column value extracted from a CassValue.
+//
+// Extracting the value doesn't touch v8 so it can be done off the main
+// thread. For strings and blobs the data points into the response buffer
+// owned by the result.
+struct DecodedValue {
+    bool is_null_;
+    union {
+        cass_int32_t int32_;
+        cass_int64_t int64_;
+        cass_float_t float_;
+        cass_double_t double_;
+        cass_bool_t bool_;
+        CassUuid uuid_;
+        CassInet inet_;
+    };
+
+    // String, blob and varint data, or the unscaled part of a decimal (with
+    // the scale in int32_)
+    const char* data_;
+    size_t size_;
+};
+
 class TypeMapper {
 public:
     // Given a type code, extract the cassandra type from the low bits
@@ -15,6 +52,14 @@ public:
         return code & ~0xffff;
     }
 
+    // Encoding to convert 64 bit values to and from BigInt. Only supported if
+    // HAVE_V8_BIGINT is defined.
+    static const u_int32_t BIGINT_AS_BIGINT = 0x3 << 16;
+
+    // Encoding to reuse one Javascript string for each distinct value of a
+    // string column (see Result)
+    static const u_int32_t STRING_INTERN = 0x4 << 16;
+
     // Infer the cassandra type based on the javascript value
     static CassValueType infer_type(const v8::Local<v8::Value>& value);
 
@@ -33,15 +78,118 @@ public:
                                      CassValueType type,
                                      u_int32_t encoding);
 
-    // Append the Javascript value to the given collection
+    // Function to set a (non-null) Javascript value of a particular type as
+    // the i'th parameter to a statement
+    typedef bool (*bind_fn)(CassStatement* statement, u_int32_t i,
+                            const v8::Local<v8::Value>& value);
+
+    // Return the bind function for values of the given type code, or NULL if
+    // the type isn't supported. Numbers, strings and booleans are converted
+    // from any Javascript value, as for params that aren't bound to a
+    // prepared statement. Collection elements are encoded using type
+    // inference.
+    static bind_fn binder(u_int32_t code);
+
+    // Function to append a (non-null) Javascript value of a particular type
+    // to a collection
+    typedef bool (*append_fn)(CassCollection* collection,
+                              const v8::Local<v8::Value>& value);
+
+    // Return the append function for elements of the given type, or NULL if
+    // the type isn't supported.
+    static append_fn appender(CassValueType type);
+
+    // Binds values of a parameter whose type is fully known, as for the
+    // parameters of a prepared statement. Unlike a bind function, values
+    // that don't have the Javascript type expected for the cassandra type
+    // fail to bind, and the elements of a collection are encoded according
+    // to its sub-types.
+    struct ParamBinder {
+        ParamBinder()
+            : type_(CASS_VALUE_TYPE_UNKNOWN)
+            , key_type_(CASS_VALUE_TYPE_UNKNOWN)
+            , bind_(NULL)
+            , primary_(NULL)
+            , secondary_(NULL) {}
+
+        // Return false if values of the type can't be bound
+        bool is_valid() const { return bind_ != NULL || primary_ != NULL; }
+
+        bool bind(CassStatement* statement, u_int32_t i,
+                  const v8::Local<v8::Value>& value) const;
+
+        CassValueType type_;
+        CassValueType key_type_;
+
+        // Set for everything but collections
+        bind_fn bind_;
+
+        // Set for collections: the elements of a list or set, or the keys
+        // and values of a map
+        append_fn primary_;
+        append_fn secondary_;
+    };
+
+    // Return the binder for a parameter of the given type and, for
+    // collections, sub-types
+    static ParamBinder param_binder(CassValueType type,
+                                    CassValueType primary_type,
+                                    CassValueType secondary_type);
+
+    // Bind each element of params to statement using the binder at the same
+    // position, as built from the types of a prepared statement's
+    // parameters.
+    //
+    // If the number of params doesn't match or one of the bindings fails,
+    // return the index of the offending element or -1 if successful.
+    static int bind_statement_params(CassStatement* statement,
+                                     v8::Local<v8::Array> params,
+                                     const std::vector<ParamBinder>& binders);
+
+    // Append the Javascript value to the given collection, using type
+    // inference to encode it
     static bool append_collection(CassCollection* collection,
                                   const v8::Local<v8::Value>& value);
 
+    // Return true if values of the given type can be extracted by decode_value.
+    static bool is_scalar(CassValueType type);
+
+    // Extract the scalar CassValue of the given type. Safe to call from any
+    // thread.
+    static bool decode_value(DecodedValue* result,
+                             u_int32_t code,
+                             const CassValue* value);
+
+    // Return true if the data contains only 7 bit characters
+    static bool is_ascii(const char* data, size_t size);
+
+    // Create a Javascript string from the contents of a column of the given
+    // string type, skipping UTF-8 decoding when the data is ASCII.
+    static v8::Local<v8::String> new_string(const char* data, size_t size,
+                                            CassValueType type);
+
+    // Like new_string, but return the internalized string with the given
+    // contents, which is shared by all equal internalized strings including
+    // property names.
+    static v8::Local<v8::String> new_internalized_string(const char* data,
+                                                         size_t size,
+                                                         CassValueType type);
+
+    // Get a Javascript result value for a value extracted by decode_value.
+    static bool v8_from_decoded(v8::Local<v8::Value>* result,
+                                u_int32_t code,
+                                const DecodedValue& value,
+                                SharedResult* owner = NULL);
+
     // Get a Javascript result value for the given CassValue of the given type.
     // Will use inference if type is CASS_VALUE_UNKNOWN.
+    //
+    // If owner is given, encodings that reference the response buffer
+    // directly (e.g. BLOB_ZERO_COPY) take a reference on it.
     static bool v8_from_cassandra(v8::Local<v8::Value>* result,
                                   u_int32_t code,
-                                  const CassValue* value);
+                                  const CassValue* value,
+                                  SharedResult* owner = NULL);
 };
 
 #endif
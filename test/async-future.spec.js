@@ -105,6 +105,106 @@ describe('async-future callbacks', function() {
         interval = setInterval(timer, 900);
     });
 
+    it('spreads callbacks across turns of the event loop with a drain budget', function() {
+        var budgeted = new TestClient({drain_count_budget: 2});
+        var cql = util.format('SELECT * FROM %s where ROW = \'row-1\'', table);
+
+        return budgeted.connect({contactPoints: test_utils.cassandra_host()})
+        .then(function() {
+            return budgeted.execute('USE ' + test_utils.ks);
+        })
+        .then(function() {
+            budgeted.metrics(true); // reset metrics
+            return Promise.all(_.times(20, function() {
+                return budgeted.execute(cql, []);
+            }));
+        })
+        .then(function(results) {
+            expect(results.length).equal(20);
+
+            var metrics = budgeted.metrics();
+            expect(metrics.response_count).equal(20);
+            expect(metrics.response_queue_drain_count_max).most(2);
+
+            var histogram = metrics.response_queue_drain_time_histogram;
+            var drains = _.reduce(histogram, function(a, b) { return a + b; }, 0);
+            expect(drains).least(10);
+        })
+        .finally(function() {
+            return budgeted.cleanup();
+        });
+    });
+
+    it('records latency histograms per statement', function() {
+        var tagged = new TestClient({statement_metrics: 1});
+        var cql = util.format('SELECT * FROM %s where ROW = ?', table);
+
+        return tagged.connect({contactPoints: test_utils.cassandra_host()})
+        .then(function() {
+            return tagged.execute('USE ' + test_utils.ks);
+        })
+        .then(function() {
+            tagged.metrics(true); // reset metrics
+            return Promise.all(_.times(10, function(i) {
+                return tagged.execute(cql, ['row-' + i], {prepare: true});
+            }));
+        })
+        .then(function() {
+            return Promise.all(_.times(5, function() {
+                return tagged.execute('SELECT * FROM ' + table + ' LIMIT 1', [], {tag: 'scan'});
+            }));
+        })
+        .then(function() {
+            var statements = tagged.metrics(true).statements;
+            expect(_.keys(statements).sort()).deep.equal([cql, 'scan'].sort());
+            expect(statements[cql].count).equal(10);
+            expect(statements.scan.count).equal(5);
+
+            var wire = statements[cql].wire;
+            expect(wire.min).most(wire.median);
+            expect(wire.median).most(wire.p99);
+            expect(wire.p99).most(wire.max);
+            expect(wire.max).above(0);
+            expect(statements[cql].queue.max).least(0);
+
+            // Resetting keeps the statements but empties their histograms
+            expect(tagged.metrics().statements).deep.equal({});
+        })
+        .finally(function() {
+            return tagged.cleanup();
+        });
+    });
+
+    it('delivers callbacks in batches with batchCallbacks', function() {
+        var batched = new TestClient({batchCallbacks: true});
+        var cql = util.format('SELECT * FROM %s where ROW = \'row-1\'', table);
+
+        return batched.connect({contactPoints: test_utils.cassandra_host()})
+        .then(function() {
+            return batched.execute('USE ' + test_utils.ks);
+        })
+        .then(function() {
+            return Promise.all(_.times(20, function() {
+                return batched.execute(cql, []);
+            }));
+        })
+        .then(function(results) {
+            expect(results.length).equal(20);
+            _.each(results, function(result) {
+                expect(result.rows).deep.equal(results[0].rows);
+            });
+            return batched.execute('SELECT * FROM no_such_table', []);
+        })
+        .then(function() {
+            throw new Error('expected an error');
+        }, function(err) {
+            expect(err.message).match(/no_such_table/);
+        })
+        .finally(function() {
+            return batched.cleanup();
+        });
+    });
+
     after(function() {
         return client.cleanup();
     });
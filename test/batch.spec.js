@@ -54,8 +54,12 @@ describe('batch queries', function() {
         var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
         return client.prepare(cql)
             .then(function(prepared) {
+                // The prepared types would reject the strings before they
+                // are sent, so encode them as given
+                var varchar = TestClient.types.CASS_VALUE_TYPE_VARCHAR;
                 var batch = client.new_batch('unlogged');
-                batch.add_prepared(prepared, ["foo", "bar", "baz"]);
+                batch.add_prepared(prepared, ["foo", "bar", "baz"],
+                                   {param_types: [varchar, varchar, varchar]});
                 Promise.promisifyAll(batch);
                 return batch.executeAsync({});
             })
@@ -70,6 +74,45 @@ describe('batch queries', function() {
             });
     });
 
+    it('adds no rows of columns to a batch if one fails to bind', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        return client.prepare(cql)
+            .then(function(prepared) {
+                var batch = client.new_batch('unlogged');
+                var rows = ['columns-0', 'columns-1', 'columns-2'];
+                var cols = new Int32Array([0, 1, 2]);
+                expect(function() {
+                    batch.add_prepared_columns(prepared, [rows, cols, [1, 2, 'three']]);
+                }).throw(/error binding row 2/);
+
+                batch.add_prepared(prepared, ['columns-ok', 0, 0]);
+                Promise.promisifyAll(batch);
+                return batch.executeAsync({});
+            })
+            .then(function() {
+                return client.execute('SELECT * FROM ' + table + ' WHERE row IN (?, ?, ?)',
+                                      ['columns-0', 'columns-1', 'columns-ok']);
+            })
+            .then(function(results) {
+                expect(_.pluck(results.rows, 'row')).deep.equal(['columns-ok']);
+            });
+    });
+
+    it('rejects a rowCount that is not a non-negative integer', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        return client.prepare(cql)
+            .then(function(prepared) {
+                var batch = client.new_batch('unlogged');
+                var columns = [['a', 'b'], new Int32Array(2), new Int32Array(2)];
+                _.each([1.5, -1, NaN, '1'], function(rowCount) {
+                    expect(function() {
+                        batch.add_prepared_columns(prepared, columns, {rowCount: rowCount});
+                    }).throw(/rowCount must be a non-negative integer/);
+                });
+                batch.add_prepared_columns(prepared, columns, {rowCount: 1});
+            });
+    });
+
     it('errors properly if a bogus query is added to a batch', function() {
         var bogus = [null, undefined, {}, 1, "foo"];
         return Promise.map(bogus, function(bad) {
@@ -49,6 +49,40 @@ describe('bigint example', function() {
         });
     });
 
+    // Needs node with BigInt support
+    var bigintIt = typeof BigInt === 'function' ? it : it.skip;
+    var bigint_codes = [
+        types.CASS_VALUE_TYPE_VARCHAR,
+        types.CASS_VALUE_TYPE_BIGINT | encodings.BIGINT_AS_BIGINT
+    ];
+
+    bigintIt('queries the data using the bigint encoding (full precision)', function() {
+        return client.execute('select key, value from bigint_example', [], {result_types: bigint_codes})
+        .then(function(results) {
+            expect(results.rows[0].value).equal(BigInt('0x1234567812345678'));
+        });
+    });
+
+    bigintIt('inserts BigInt values and returns them as a BigInt64Array', function() {
+        var big = BigInt('-0x7edcba9876543210');
+        return client.execute('insert into bigint_example (key, value) values (?, ?)',
+                              ["test_key_2", big])
+        .then(function() {
+            return client.execute('select key, value from bigint_example where key in (?, ?)',
+                ["test_key", "test_key_2"],
+                {result_types: bigint_codes, rowMode: 'columnar'});
+        })
+        .then(function(results) {
+            var keys = results.values[0];
+            var values = results.values[1];
+            expect(values).instanceof(BigInt64Array);
+            expect(_.object(keys, Array.prototype.slice.call(values))).deep.equal({
+                test_key: BigInt('0x1234567812345678'),
+                test_key_2: big
+            });
+        });
+    });
+
     after(function() {
         return client.cleanup();
     });
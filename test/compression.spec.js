@@ -0,0 +1,84 @@
+var TestClient = require('./test-client');
+var Promise = require('bluebird');
+var expect = require('chai').expect;
+var _ = require('underscore');
+var util = require('util');
+var test_utils = require('./test-utils');
+
+var table = 'compression_test';
+var fields = {
+    'row': 'varchar',
+    'col': 'int',
+    'val': 'int'
+};
+
+var key = 'row, col';
+var client;
+
+describe('compression', function() {
+    before(function() {
+        client = new TestClient();
+        return test_utils.setup_environment(client)
+            .then(function() {
+                return client.createTable(table, fields, key);
+            });
+    });
+
+    after(function() {
+        return client.cleanup();
+    });
+
+    // Connect a client with the given options to the test keyspace, run fn
+    // with it and clean it up afterwards
+    function withClient(opts, fn) {
+        var c = new TestClient(opts);
+        return c.connect({contactPoints: test_utils.cassandra_host()})
+        .then(function() {
+            return c.execute('USE ' + test_utils.ks);
+        })
+        .then(function() {
+            return fn(c);
+        })
+        .finally(function() {
+            return c.cleanup();
+        });
+    }
+
+    // Insert a row with a long key and read it back
+    function roundTrip(c, length) {
+        var row = 'row-' + _.times(length, function(i) { return 'abcd' + (i % 7); }).join('');
+        var insert = util.format('INSERT INTO %s (row, col, val) VALUES (\'%s\', 1, 2)',
+                                 table, row);
+        var select = util.format('SELECT * FROM %s where ROW = \'%s\'', table, row);
+
+        return c.execute(insert, [])
+        .then(function() {
+            return c.execute(select, []);
+        })
+        .then(function(result) {
+            expect(result.rows.length).equal(1);
+            expect(result.rows[0].row).equal(row);
+            expect(result.rows[0].val).equal(2);
+        });
+    }
+
+    it('round trips large values with lz4 compression', function() {
+        return withClient({compression: 'lz4', compression_threshold: 0}, function(c) {
+            return roundTrip(c, 500);
+        });
+    });
+
+    it('round trips values on either side of the compression threshold', function() {
+        return withClient({compression: 'lz4', compression_threshold: 1024}, function(c) {
+            return Promise.each([10, 1000], function(length) {
+                return roundTrip(c, length);
+            });
+        });
+    });
+
+    it('rejects unsupported compression', function() {
+        expect(function() {
+            return new TestClient({compression: 'snappy'});
+        }).throw(/unsupported compression/);
+    });
+});
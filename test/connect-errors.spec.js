@@ -2,6 +2,7 @@ var TestClient = require('./test-client');
 var _ = require('underscore');
 var Promise = require('bluebird');
 var expect = require('chai').expect;
+var test_utils = require('./test-utils');
 
 describe('connection error handling', function() {
     it('fails if connect is called without options', function() {
@@ -85,6 +86,33 @@ describe('connection error handling', function() {
         });
     });
 
+    it('fails if the client is created with an empty local_dc', function() {
+        expect(function() {
+            return new TestClient({local_dc: ''});
+        }).to.throw('invalid local_dc');
+    });
+
+    it('connects with load balancing options', function() {
+        var client = new TestClient({
+            local_dc: 'datacenter1',
+            used_hosts_per_remote_dc: 1,
+            token_aware_routing: 1,
+            latency_aware_routing: 1,
+            latency_exclusion_threshold: 1.5,
+            latency_min_measured: 10
+        });
+        return client.connect({contactPoints: test_utils.cassandra_host()})
+        .then(function() {
+            return client.execute('SELECT release_version FROM system.local');
+        })
+        .then(function(result) {
+            expect(result.rows.length).equal(1);
+        })
+        .finally(function() {
+            return client.cleanup();
+        });
+    });
+
     it('fails to connect repeatedly to a non-listening contactPoints', function() {
         var client = new TestClient();
         this.timeout(30000);
@@ -0,0 +1,99 @@
+var TestClient = require('./test-client');
+var Promise = require('bluebird');
+var expect = require('chai').expect;
+var table = 'lazy_rows_test';
+var _ = require('underscore');
+var util = require('util');
+var test_utils = require('./test-utils');
+var types = TestClient.types;
+var encodings = TestClient.encodings;
+
+var fields = {
+    'row': 'varchar',
+    'col': 'int',
+    'val': 'int'
+};
+
+var key = 'row, col';
+var data = test_utils.generate(100);
+var client;
+
+describe('lazy rows', function() {
+    before(function() {
+        client = new TestClient();
+        return test_utils.setup_environment(client)
+            .then(function() {
+                return client.createTable(table, fields, key);
+            })
+            .then(function() {
+                return client.insertRows(table, data);
+            });
+    });
+
+    it('decodes columns on access', function() {
+        return client.execute('select * from ' + table, [],
+            {lazyRows: true, fetchSize: 30, autoPage: true})
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length);
+
+            var rows = _.sortBy(results.rows, 'col');
+            for (var i = 0; i < rows.length; ++i) {
+                expect(rows[i].col).equal(i);
+                expect(rows[i].row).equal(data[i].row);
+                expect(rows[i].val).equal(data[i].val);
+            }
+        });
+    });
+
+    it('exposes the columns as enumerable properties', function() {
+        return client.execute(util.format('select row, col, val from %s where row = ? and col = ?', table),
+            [data[7].row, 7], {lazyRows: true})
+        .then(function(results) {
+            var row = results.rows[0];
+            expect(_.keys(row)).deep.equal(['row', 'col', 'val']);
+            expect(JSON.parse(JSON.stringify(row))).deep.equal(data[7]);
+        });
+    });
+
+    it('allows columns to be assigned', function() {
+        return client.execute(util.format('select row, col, val from %s where row = ? and col = ?', table),
+            [data[7].row, 7], {lazyRows: true})
+        .then(function(results) {
+            var row = results.rows[0];
+            row.val = 'changed';
+            expect(row.val).equal('changed');
+            expect(row.col).equal(7);
+        });
+    });
+
+    it('decodes predecoded pages on access', function() {
+        return client.execute('select * from ' + table, [],
+            {lazyRows: true, predecode: true, fetchSize: 30, autoPage: true})
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length);
+
+            var rows = _.sortBy(results.rows, 'col');
+            for (var i = 0; i < rows.length; ++i) {
+                expect(rows[i].col).equal(i);
+                expect(rows[i].val).equal(data[i].val);
+            }
+        });
+    });
+
+    it('interns string columns', function() {
+        var result_types = [types.CASS_VALUE_TYPE_VARCHAR | encodings.STRING_INTERN,
+                            types.CASS_VALUE_TYPE_INT, types.CASS_VALUE_TYPE_INT];
+        return client.execute(util.format('select row, col, val from %s', table), [],
+            {lazyRows: true, result_types: result_types})
+        .then(function(results) {
+            var rows = _.sortBy(results.rows, 'col');
+            for (var i = 0; i < rows.length; ++i) {
+                expect(rows[i].row).equal(data[i].row);
+            }
+        });
+    });
+
+    after(function() {
+        return client.cleanup();
+    });
+});
@@ -62,6 +62,62 @@ describe('paging', function() {
             });
     });
 
+    it('execute autoPage fetches all data without prefetching', function() {
+        return client.execute('select * from ' + table, [],
+        {fetchSize: 7, autoPage: true, prefetch: false})
+            .then(function(results) {
+                expect(results.rows.length).equal(data.length);
+                var rows = _.sortBy(results.rows, 'col');
+                for (i = 0; i < rows.length; ++i) {
+                    expect(rows[i].col).equal(i);
+                }
+            });
+    });
+
+    it('execute pageState discards a prefetched page', function() {
+        var cols = [];
+        return client.execute('select * from ' + table, [],
+            {fetchSize: data.length / 2, prefetch: true})
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length / 2);
+            cols = cols.concat(_.pluck(results.rows, 'col'));
+            return client.execute('select * from ' + table, [],
+                {fetchSize: data.length / 2, pageState: results.pageState, prefetch: true});
+        })
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length / 2);
+            cols = cols.concat(_.pluck(results.rows, 'col'));
+
+            cols.sort(function(a,b) { return a - b; });
+            for (i = 0; i < cols.length; ++i) {
+                expect(cols[i]).equal(i);
+            }
+        });
+    });
+
+    it('execute pageState drops a prefetched page of another size', function() {
+        var query = 'select * from ' + table;
+        return client.execute(query, [],
+            {fetchSize: data.length / 4, prefetch: true, prepare: true})
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length / 4);
+            return client.execute(query, [],
+                {fetchSize: data.length, pageState: results.pageState, prepare: true});
+        })
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length * 3 / 4);
+        });
+    });
+
+    it('execute autoPage leaves the options unchanged', function() {
+        var options = {fetchSize: 7, autoPage: true};
+        return client.execute('select * from ' + table, [], options)
+            .then(function(results) {
+                expect(results.rows.length).equal(data.length);
+                expect(options).deep.equal({fetchSize: 7, autoPage: true});
+            });
+    });
+
     it('eachRow returns only one chunk at a time', function() {
         var rows = [];
         function addRow(row) {
@@ -101,6 +157,48 @@ describe('paging', function() {
             });
     });
 
+    it('stream reads all data one page at a time', function() {
+        var rows = [];
+        var stream = client.stream('select * from ' + table, [], {fetchSize: 7});
+        return new Promise(function(resolve, reject) {
+            stream.on('data', function(row) {
+                rows.push(row);
+                expect(stream._readableState.length).most(14);
+            });
+            stream.on('error', reject);
+            stream.on('end', resolve);
+        })
+        .then(function() {
+            expect(rows.length).equal(data.length);
+            rows = _.sortBy(rows, 'col');
+            for (i = 0; i < rows.length; ++i) {
+                expect(rows[i].col).equal(i);
+            }
+        });
+    });
+
+    it('stream stops fetching while the consumer is behind', function() {
+        var stream = client.stream('select * from ' + table, [], {fetchSize: 10});
+        return new Promise(function(resolve, reject) {
+            stream.once('readable', resolve);
+            stream.on('error', reject);
+        })
+        .delay(100)
+        .then(function() {
+            // Only the first page is fetched until rows are consumed
+            expect(stream._readableState.length).equal(10);
+            var count = 0;
+            return new Promise(function(resolve, reject) {
+                stream.on('data', function() { count++; });
+                stream.on('error', reject);
+                stream.on('end', function() { resolve(count); });
+            });
+        })
+        .then(function(count) {
+            expect(count).equal(data.length);
+        });
+    });
+
     after(function() {
         return client.cleanup();
     });
@@ -60,6 +60,237 @@ describe('prepared queries', function() {
             });
     });
 
+    it('returns the same columns from each query of a prepared query', function() {
+        var cql = util.format('SELECT row, col, val FROM %s where ROW = ? and col < ?', table);
+        var modes = [{}, {rowMode: 'array'}, {lazyRows: true}, {}];
+        return client.prepare(cql)
+            .then(function(prepared) {
+                return Promise.reduce(modes, function(results, options) {
+                    var q = prepared.query();
+                    q.bind(['row-3', 1000000000], {});
+                    Promise.promisifyAll(q);
+                    return q.executeAsync(options).then(function(result) {
+                        return results.concat([result]);
+                    });
+                }, []);
+            })
+            .then(function(results) {
+                expect(results[1].columns).deep.equal(['row', 'col', 'val']);
+                _.each([0, 2, 3], function(i) {
+                    expect(results[i].rows.length).equal(data.length / 10);
+                    expect(_.keys(results[i].rows[0]).sort()).deep.equal(['col', 'row', 'val']);
+                    expect(results[i].rows[0].row).equal('row-3');
+                });
+            });
+    });
+
+    it('executes queries with the prepare option', function() {
+        var cql = util.format('SELECT * FROM %s where ROW = ? and col < ?', table);
+        var rows = _.times(10, function (i) { return 'row-' + i; });
+
+        // All but the first of these wait for the same prepare
+        return Promise.map(rows, function(row) {
+            return client.execute(cql, [row, 1000000000], {prepare: true});
+        })
+        .then(function(results) {
+            var cols = _.pluck(_.flatten(_.pluck(results, 'rows')), 'col');
+            expect(cols.length).equal(data.length);
+
+            // This one comes from the cache
+            return client.execute(cql, ['row-1', 1000000000], {prepare: true});
+        })
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length / 10);
+        });
+    });
+
+    it('pages through results with the prepare option', function() {
+        var cql = util.format('SELECT * FROM %s where ROW = ?', table);
+        return client.execute(cql, ['row-2'], {prepare: true, fetchSize: 3, autoPage: true})
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length / 10);
+        });
+    });
+
+    it('prepares the query again after the cache is cleared', function() {
+        var cql = util.format('SELECT * FROM %s where ROW = ?', table);
+        return client.execute(cql, ['row-4'], {prepare: true})
+        .then(function() {
+            client.client.clearPreparedCache();
+            return client.execute(cql, ['row-4'], {prepare: true});
+        })
+        .then(function(results) {
+            expect(results.rows.length).equal(data.length / 10);
+        });
+    });
+
+    it('reports prepare errors with the prepare option', function() {
+        return client.execute('SELECT * FROM no_such_table', [], {prepare: true})
+        .then(function() {
+            throw new Error('expected an error');
+        }, function(err) {
+            expect(err.message).match(/no_such_table/);
+        });
+    });
+
+    it('inserts data using executeMany', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        var params = _.times(50, function(i) { return ['many', i, i * 2]; });
+
+        return client.prepare(cql)
+            .then(function(prepared) {
+                return client.executeMany(prepared, params, {concurrency: 8});
+            })
+            .then(function(results) {
+                expect(results.count).equal(params.length);
+                expect(results.failed).equal(0);
+                expect(results.errors).deep.equal([]);
+
+                return client.execute(util.format('SELECT * FROM %s where ROW = ?', table), ['many']);
+            })
+            .then(function(results) {
+                var rows = _.sortBy(results.rows, 'col');
+                expect(rows.length).equal(params.length);
+                for (i = 0; i < rows.length; ++i) {
+                    expect(rows[i].val).equal(i * 2);
+                }
+            });
+    });
+
+    it('reports per row errors from executeMany', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        var params = [
+            ['many-errors', 0, 0],
+            ['many-errors', 1, 1, 'extra'],
+            ['many-errors', 2, 2],
+            'not an array'
+        ];
+
+        return client.prepare(cql)
+            .then(function(prepared) {
+                return client.executeMany(prepared, params);
+            })
+            .then(function(results) {
+                expect(results.count).equal(params.length);
+                expect(results.failed).equal(2);
+                expect(_.pluck(results.errors, 'index').sort()).deep.equal([1, 3]);
+                _.each(results.errors, function(error) {
+                    expect(error.error).instanceof(Error);
+                });
+            });
+    });
+
+    it('inserts columns of data using executeMany', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        var n = 50;
+        var rows = _.times(n, function() { return 'many-columns'; });
+        var cols = new Int32Array(n);
+        var vals = new Int32Array(n);
+        for (var i = 0; i < n; ++i) {
+            cols[i] = i;
+            vals[i] = i * 3;
+        }
+
+        return client.prepare(cql)
+            .then(function(prepared) {
+                return client.executeMany(prepared, [rows, cols, vals], {columnar: true, rowCount: 40});
+            })
+            .then(function(results) {
+                expect(results.count).equal(40);
+                expect(results.failed).equal(0);
+
+                return client.execute(util.format('SELECT * FROM %s where ROW = ?', table), ['many-columns']);
+            })
+            .then(function(results) {
+                var rows = _.sortBy(results.rows, 'col');
+                expect(rows.length).equal(40);
+                for (i = 0; i < rows.length; ++i) {
+                    expect(rows[i].val).equal(i * 3);
+                }
+            });
+    });
+
+    it('rejects columns that do not match the prepared query', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        return client.prepare(cql)
+            .then(function(prepared) {
+                var rows = ['a', 'b'];
+                var cols = new Int32Array(2);
+                expect(function() {
+                    client.client.executeMany(prepared, [rows, cols, new Float64Array(2)],
+                        {columnar: true}, function() {});
+                }).throw(/column 2/);
+                expect(function() {
+                    client.client.executeMany(prepared, [rows, cols, cols],
+                        {columnar: true, rowCount: 3}, function() {});
+                }).throw(/row count/);
+            });
+    });
+
+    it('binds only integral Float64Array values to bigint columns', function() {
+        var bigints = 'prepared_bigint_test';
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', bigints);
+        var rows = ['float-bigint', 'float-bigint', 'float-bigint', 'float-bigint'];
+        var cols = new Int32Array([0, 1, 2, 3]);
+        var vals = new Float64Array([1420070400000, 1.5, NaN, Math.pow(2, 64)]);
+
+        return client.createTable(bigints, {row: 'varchar', col: 'int', val: 'bigint'}, key)
+            .then(function() {
+                return client.prepare(cql);
+            })
+            .then(function(prepared) {
+                return client.executeMany(prepared, [rows, cols, vals], {columnar: true});
+            })
+            .then(function(results) {
+                expect(results.count).equal(4);
+                expect(results.failed).equal(3);
+                expect(_.pluck(results.errors, 'index').sort()).deep.equal([1, 2, 3]);
+
+                return client.execute(util.format('SELECT * FROM %s where ROW = ?', bigints), ['float-bigint']);
+            })
+            .then(function(results) {
+                expect(results.rows.length).equal(1);
+                expect(results.rows[0].val).equal(1420070400000);
+            });
+    });
+
+    it('calls back from executeMany with no params', function() {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        return client.prepare(cql)
+            .then(function(prepared) {
+                return client.executeMany(prepared, []);
+            })
+            .then(function(results) {
+                expect(results.count).equal(0);
+                expect(results.failed).equal(0);
+            });
+    });
+
+    it('calls back from executeMany after it returns', function(done) {
+        var cql = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', table);
+        client.prepare(cql)
+            .then(function(prepared) {
+                var returned = false;
+                client.client.executeMany(prepared, ['not an array'], {}, function(err, results) {
+                    expect(returned).equal(true);
+                    expect(results.failed).equal(1);
+                    done();
+                });
+                returned = true;
+            })
+            .catch(done);
+    });
+
+    it('rejects executeMany without a prepared query', function() {
+        var unprepared = client.client.client.new_prepared_query();
+        expect(function() {
+            client.client.executeMany({}, [], {}, function() {});
+        }).throw(/valid prepared object/);
+        expect(function() {
+            client.client.executeMany(unprepared, [], {}, function() {});
+        }).throw(/after prepare/);
+    });
+
     after(function() {
         return client.cleanup();
     });
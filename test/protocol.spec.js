@@ -0,0 +1,120 @@
+var TestClient = require('./test-client');
+var Promise = require('bluebird');
+var expect = require('chai').expect;
+var _ = require('underscore');
+var util = require('util');
+var test_utils = require('./test-utils');
+
+var table = 'protocol_test';
+var fields = {
+    'row': 'varchar',
+    'col': 'int',
+    'val': 'int'
+};
+
+var key = 'row, col';
+var data = test_utils.generate(100);
+var client;
+
+describe('protocol versions', function() {
+    before(function() {
+        client = new TestClient();
+        return test_utils.setup_environment(client)
+            .then(function() {
+                return client.createTable(table, fields, key);
+            })
+            .then(function() {
+                return client.insertRows(table, data);
+            });
+    });
+
+    after(function() {
+        return client.cleanup();
+    });
+
+    // Connect a client with the given options to the test keyspace, run fn
+    // with it and clean it up afterwards
+    function withClient(opts, fn) {
+        var c = new TestClient(opts);
+        return c.connect({contactPoints: test_utils.cassandra_host()})
+        .then(function() {
+            return c.execute('USE ' + test_utils.ks);
+        })
+        .then(function() {
+            return fn(c);
+        })
+        .finally(function() {
+            return c.cleanup();
+        });
+    }
+
+    it('runs more than 128 concurrent requests on a single connection', function() {
+        var opts = {
+            core_connections_per_host: 1,
+            max_connections_per_host: 1
+        };
+        var cql = util.format('SELECT * FROM %s where ROW = \'row-1\'', table);
+
+        return withClient(opts, function(single) {
+            return Promise.all(_.times(500, function() {
+                return single.execute(cql, []);
+            }))
+            .then(function(results) {
+                expect(results.length).equal(500);
+                expect(single.metrics().total_connections).equal(1);
+            });
+        });
+    });
+
+    // Pages of 4KB blobs make frames that are copied out of the read buffer
+    // (3 rows), decoded in place (5 rows) or spread over several reads (50
+    // rows), with and without compression.
+    _.each([{}, {compression: 'lz4', compression_threshold: 0}], function(opts) {
+        it('decodes frames of any size ' + (opts.compression ? 'with' : 'without') +
+           ' compression', function() {
+            var blobs = 'protocol_blobs';
+            var rows = _.times(50, function(i) {
+                return new Buffer(_.times(4096, function(j) { return (i + j) & 0xff; }));
+            });
+            var insert = util.format('INSERT INTO %s (row, col, val) VALUES (?, ?, ?)', blobs);
+            var select = util.format('SELECT * FROM %s WHERE row = ?', blobs);
+
+            return client.createTable(blobs, {row: 'varchar', col: 'int', val: 'blob'}, key)
+            .then(function() {
+                return Promise.map(rows, function(blob, i) {
+                    return client.execute(insert, ['blobs', i, blob], {prepare: true});
+                });
+            })
+            .then(function() {
+                return withClient(opts, function(c) {
+                    return Promise.each([3, 5, 50], function(fetchSize) {
+                        return c.execute(select, ['blobs'], {fetchSize: fetchSize, autoPage: true})
+                        .then(function(result) {
+                            expect(result.rows.length).equal(rows.length);
+                            _.each(result.rows, function(row) {
+                                expect(row.val.equals(rows[row.col])).equal(true);
+                            });
+                        });
+                    });
+                });
+            });
+        });
+    });
+
+    it('queries and pages with protocol version 2', function() {
+        var cql = util.format('SELECT * FROM %s', table);
+
+        return withClient({protocol_version: 2}, function(v2) {
+            return Promise.all(_.times(100, function() {
+                return v2.execute(cql, [], {fetchSize: 30, autoPage: true});
+            }))
+            .then(function(results) {
+                _.each(results, function(result) {
+                    expect(result.rows.length).equal(data.length);
+                    var cols = _.pluck(result.rows, 'col').sort(function(a, b) { return a - b; });
+                    expect(cols).deep.equal(_.range(data.length));
+                });
+            });
+        });
+    });
+});
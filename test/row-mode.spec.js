@@ -0,0 +1,126 @@
+var TestClient = require('./test-client');
+var Promise = require('bluebird');
+var expect = require('chai').expect;
+var table = 'row_mode_test';
+var _ = require('underscore');
+var util = require('util');
+var test_utils = require('./test-utils');
+
+var fields = {
+    'row': 'varchar',
+    'col': 'int',
+    'val': 'int',
+    'dbl': 'double'
+};
+
+var key = 'row, col';
+var data = _.map(test_utils.generate(100), function(d) {
+    d.dbl = d.val / 4;
+    return d;
+});
+var client;
+
+describe('row modes', function() {
+    before(function() {
+        client = new TestClient();
+        return test_utils.setup_environment(client)
+            .then(function() {
+                return client.createTable(table, fields, key);
+            })
+            .then(function() {
+                return client.insertRows(table, data, {
+                    param_types: {dbl: TestClient.types.CASS_VALUE_TYPE_DOUBLE}
+                });
+            });
+    });
+
+    it('returns rows as arrays', function() {
+        return client.execute('select row, col, val from ' + table, [], {rowMode: 'array'})
+        .then(function(results) {
+            expect(results.columns).deep.equal(['row', 'col', 'val']);
+            expect(results.rows.length).equal(data.length);
+
+            var rows = _.sortBy(results.rows, function(row) { return row[1]; });
+            for (var i = 0; i < rows.length; ++i) {
+                expect(rows[i]).deep.equal([data[i].row, data[i].col, data[i].val]);
+            }
+        });
+    });
+
+    it('returns columns with typed arrays for numeric types', function() {
+        return client.execute('select row, col, dbl from ' + table, [],
+            {rowMode: 'columnar', fetchSize: 30, autoPage: true})
+        .then(function(results) {
+            expect(results.rows).is.undefined();
+            expect(results.columns).deep.equal(['row', 'col', 'dbl']);
+            expect(results.values.length).equal(3);
+            expect(results.values[0]).instanceof(Array);
+            expect(results.values[1]).instanceof(Int32Array);
+            expect(results.values[2]).instanceof(Float64Array);
+
+            var cols = results.values[1];
+            expect(cols.length).equal(data.length);
+            for (var i = 0; i < cols.length; ++i) {
+                var d = data[cols[i]];
+                expect(results.values[0][i]).equal(d.row);
+                expect(results.values[2][i]).equal(d.dbl);
+            }
+        });
+    });
+
+    it('falls back to arrays for numeric columns with nulls', function() {
+        return client.execute(util.format('INSERT INTO %s (row, col) VALUES (?, ?)', table),
+            ['row-null', 0])
+        .then(function() {
+            return client.execute(util.format('select col, val from %s where row = ?', table),
+                ['row-null'], {rowMode: 'columnar'});
+        })
+        .then(function(results) {
+            expect(results.values[0]).instanceof(Int32Array);
+            expect(results.values[1]).deep.equal([null]);
+        });
+    });
+
+    it('eachRow returns rows as arrays', function() {
+        var rows = [];
+        return client.eachRow('select col from ' + table, [],
+            {rowMode: 'array', fetchSize: 30, autoPage: true},
+            function(row) {
+                rows.push(row);
+            })
+        .then(function() {
+            expect(rows.length).equal(data.length + 1);
+            _.each(rows, function(row) {
+                expect(row.length).equal(1);
+            });
+        });
+    });
+
+    _.each(['object', 'array', 'columnar'], function(mode) {
+        it('returns the same ' + mode + ' results when predecoded', function() {
+            var query = 'select row, col, val, dbl from ' + table;
+            var options = {rowMode: mode, fetchSize: 30, autoPage: true};
+            return Promise.all([
+                client.execute(query, [], options),
+                client.execute(query, [], _.extend({predecode: true}, options))
+            ])
+            .spread(function(results, predecoded) {
+                expect(predecoded).deep.equal(results);
+            });
+        });
+    });
+
+    it('rejects an invalid row mode', function() {
+        return client.execute('select * from ' + table, [], {rowMode: 'bogus'})
+        .then(function() {
+            throw new Error('expected an error');
+        })
+        .catch(function(err) {
+            expect(err.message).equal('invalid rowMode');
+        });
+    });
+
+    after(function() {
+        return client.cleanup();
+    });
+});
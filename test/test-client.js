@@ -29,10 +29,18 @@ var TestClient = Base.extend({
         return this.client.eachRowAsync.apply(this.client, arguments);
     },
 
+    stream: function() {
+        return this.client.stream.apply(this.client, arguments);
+    },
+
     prepare: function() {
         return this.client.prepareAsync.apply(this.client, arguments);
     },
 
+    executeMany: function() {
+        return this.client.executeManyAsync.apply(this.client, arguments);
+    },
+
     new_batch: function(style) {
         return this.client.new_batch(style);
     },
@@ -212,6 +220,33 @@ var TestClient = Base.extend({
         .then(function() {
             return Promise.map(batches, insert_batch, {concurrency: options.concurrency});
         });
+    },
+
+    insertRowsMany: function(table, data, options) {
+        var self = this;
+        var keys = _.keys(data[0]);
+        var query = this._getInsertQuery(table, data, options);
+
+        var params = _.map(data, function(d) {
+            var vals = _.map(keys, function(k) { return d[k]; });
+            if (options.timestamp && options.ttl) {
+                vals.push(options.timestamp);
+                vals.push(options.ttl);
+            }
+            return vals;
+        });
+
+        return self.client.prepareAsync(query.cql)
+        .then(function(prepared) {
+            return self.executeMany(prepared, params,
+                {param_types: query.param_types, concurrency: options.concurrency});
+        })
+        .then(function(results) {
+            if (results.failed !== 0) {
+                throw results.errors[0].error;
+            }
+            return results;
+        });
     }
 });
 
@@ -61,11 +61,33 @@ var tests = [
         value: 'lorum ipsum',
         code: types.CASS_VALUE_TYPE_TEXT
     },
+    {
+        test: 'text with non-ascii characters',
+        table: 'text_utf8',
+        type: 'text',
+        value: 'h\u00e9llo \u2603',
+        code: types.CASS_VALUE_TYPE_TEXT
+    },
+    {
+        test: 'varchar interned',
+        table: 'varchar_interned',
+        type: 'varchar',
+        value: 'us-east-1',
+        code: types.CASS_VALUE_TYPE_VARCHAR,
+        encoding: encodings.STRING_INTERN
+    },
     {
         type: 'blob',
         value: new Buffer([1, 2, 3]),
         code: types.CASS_VALUE_TYPE_BLOB
     },
+    {
+        test: 'blob zero copy',
+        type: 'blob',
+        value: new Buffer(_.times(4096, function(i) { return i & 0xff; })),
+        code: types.CASS_VALUE_TYPE_BLOB,
+        encoding: encodings.BLOB_ZERO_COPY
+    },
     {
         type: 'bigint',
         value: 2891546411504,
@@ -80,6 +102,52 @@ var tests = [
         },
         code: types.CASS_VALUE_TYPE_BIGINT,
         encoding: encodings.BIGINT_AS_OBJECT
+    },
+    {
+        type: 'uuid',
+        value: '550e8400-e29b-41d4-a716-446655440000',
+        code: types.CASS_VALUE_TYPE_UUID
+    },
+    {
+        type: 'timeuuid',
+        value: 'c9d6e5a0-1f7b-11e5-8f5e-0800200c9a66',
+        code: types.CASS_VALUE_TYPE_TIMEUUID
+    },
+    {
+        type: 'inet',
+        value: '192.168.1.20',
+        code: types.CASS_VALUE_TYPE_INET
+    },
+    {
+        test: 'inet v6',
+        table: 'inet_v6',
+        type: 'inet',
+        value: '2001:db8::ff00:42:8329',
+        code: types.CASS_VALUE_TYPE_INET
+    },
+    {
+        type: 'varint',
+        value: '-12345678901234567890123',
+        code: types.CASS_VALUE_TYPE_VARINT
+    },
+    {
+        type: 'decimal',
+        value: '123.4500',
+        code: types.CASS_VALUE_TYPE_DECIMAL
+    },
+    {
+        test: 'set',
+        table: 'set',
+        type: 'set<int>',
+        value: [1, 2, 3],
+        code: types.CASS_VALUE_TYPE_SET
+    },
+    {
+        test: 'list',
+        table: 'list',
+        type: 'list<text>',
+        value: ['b', 'a', 'b'],
+        code: types.CASS_VALUE_TYPE_LIST
     }
 ];
 
@@ -94,7 +162,7 @@ describe('type conversions', function() {
     var i = 0;
     _.each(tests, function(t) {
         describe('supports ' + t.test || t.type, function() {
-            var table = 'hint_test_' + t.type;
+            var table = 'hint_test_' + (t.table || t.type);
             var fields = {key: 'varchar', value: t.type, other: 'int'};
             var key_type = types.CASS_VALUE_TYPE_VARCHAR;
             var value_type = t.code | (t.encoding || 0);
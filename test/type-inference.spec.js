@@ -4,6 +4,8 @@ var _ = require('underscore');
 var expect = require('chai').expect;
 var test_utils = require('./test-utils');
 
+var types = TestClient.types;
+
 var client;
 var tests = {
     ascii: ['ascii', 'text'],
@@ -68,6 +70,135 @@ describe('type inference', function() {
         });
     });
 
+    it('binds prepared params using the prepared types', function() {
+        var table = 'prepared_types_test_table';
+        var cql = 'insert into ' + table + ' (key, big, dbl, flt) values (?, ?, ?, ?);';
+
+        // Without the prepared types 7 would be inferred as an int and 2 as an
+        // int or double, neither of which have the right width
+        return client.execute('create table ' + table + ' (key varchar, big bigint, dbl double, flt float, primary key(key));')
+            .then(function() {
+                return client.prepare(cql);
+            })
+            .then(function(prepared) {
+                var q = prepared.query();
+                q.bind(['key', 7, 2, 1.5], {});
+                Promise.promisifyAll(q);
+                return q.executeAsync({});
+            })
+            .then(function() {
+                return client.execute('select * from ' + table + ' where key=?;', ['key']);
+            })
+            .then(function(results) {
+                expect(results.rows[0]).deep.equal({key: 'key', big: 7, dbl: 2, flt: 1.5});
+            })
+            .finally(function() {
+                return client.execute('drop table ' + table + ';');
+            });
+    });
+
+    it('converts unprepared params to the given param_types', function() {
+        var table = 'param_types_conversion_test_table';
+        var cql = 'insert into ' + table + ' (key, ts, i, big) values (?, ?, ?, ?);';
+        var date = new Date(1450000000000);
+        var param_types = [
+            types.CASS_VALUE_TYPE_VARCHAR,
+            types.CASS_VALUE_TYPE_TIMESTAMP,
+            types.CASS_VALUE_TYPE_INT,
+            types.CASS_VALUE_TYPE_BIGINT
+        ];
+
+        return client.execute('create table ' + table + ' (key varchar, ts timestamp, i int, big bigint, primary key(key));')
+            .then(function() {
+                return client.execute(cql, [42, date, '12', '34'], {param_types: param_types});
+            })
+            .then(function() {
+                return client.execute('select * from ' + table + ' where key=?;', ['42']);
+            })
+            .then(function(results) {
+                expect(results.rows[0]).deep.equal({key: '42', ts: date.getTime(), i: 12, big: 34});
+            })
+            .finally(function() {
+                return client.execute('drop table ' + table + ';');
+            });
+    });
+
+    it('rejects prepared params that do not match the prepared statement', function() {
+        return client.prepare('select * from system.local where key = ?')
+            .then(function(prepared) {
+                var q = prepared.query();
+                expect(function() { q.bind(['local', 'extra'], {}); })
+                    .to.throw('error binding statement argument 1');
+                expect(function() { q.bind([], {}); })
+                    .to.throw('error binding statement argument 0');
+            });
+    });
+
+    it('rejects prepared params of the wrong type', function() {
+        var table = 'prepared_mismatch_test_table';
+        var cql = 'insert into ' + table + ' (key, b, i, big, dbl, flag) values (?, ?, ?, ?, ?, ?);';
+        var valid = ['key', new Buffer([1]), 1, 2, 1.5, true];
+        var mismatches = [
+            [0, undefined],
+            [0, 7],
+            [1, 'not a buffer'],
+            [2, 'one'],
+            [2, 1.5],
+            [3, 'two'],
+            [3, 0.5],
+            [3, NaN],
+            [4, {}],
+            [5, 'true']
+        ];
+
+        return client.execute('create table ' + table + ' (key varchar, b blob, i int, big bigint, dbl double, flag boolean, primary key(key));')
+            .then(function() {
+                return client.prepare(cql);
+            })
+            .then(function(prepared) {
+                prepared.query().bind(valid, {});
+                _.each(mismatches, function(mismatch) {
+                    var params = valid.slice();
+                    params[mismatch[0]] = mismatch[1];
+                    expect(function() { prepared.query().bind(params, {}); })
+                        .to.throw('error binding statement argument ' + mismatch[0]);
+                });
+            })
+            .finally(function() {
+                return client.execute('drop table ' + table + ';');
+            });
+    });
+
+    it('binds prepared collection elements using the element types', function() {
+        var table = 'prepared_collection_test_table';
+        var cql = 'insert into ' + table + ' (key, bigs, flts, ids) values (?, ?, ?, ?);';
+        var id = '550e8400-e29b-41d4-a716-446655440000';
+
+        return client.execute('create table ' + table + ' (key varchar, bigs list<bigint>, flts set<float>, ids list<uuid>, primary key(key));')
+            .then(function() {
+                return client.prepare(cql);
+            })
+            .then(function(prepared) {
+                var q = prepared.query();
+                expect(function() { prepared.query().bind(['key', [1, 'x'], [], []], {}); })
+                    .to.throw('error binding statement argument 1');
+                expect(function() { prepared.query().bind(['key', [], [], ['not a uuid']], {}); })
+                    .to.throw('error binding statement argument 3');
+                q.bind(['key', [1, 2], [1.5], [id]], {});
+                Promise.promisifyAll(q);
+                return q.executeAsync({});
+            })
+            .then(function() {
+                return client.execute('select * from ' + table + ' where key=?;', ['key']);
+            })
+            .then(function(results) {
+                expect(results.rows[0]).deep.equal({key: 'key', bigs: [1, 2], flts: [1.5], ids: [id]});
+            })
+            .finally(function() {
+                return client.execute('drop table ' + table + ';');
+            });
+    });
+
     after(function() {
         return client.cleanup();
     });